@@ -3,10 +3,13 @@
 
 #include "node.h"
 #include "astarnode.h"
+#include "stateset.h"
+#include "nodestore.h"
+#include "bucketqueue.h"
+#include "heuristic.h"
+#include "successors.h"
+#include "searchstats.h"
 #include <vector>
-#include <queue>
-#include <unordered_set>
-#include <string>
 #include <algorithm>
 
 class Astar {
@@ -14,18 +17,32 @@ public:
     Astar(const std::vector<int>& finalVector);
     std::vector<Node*> findSolution(const std::vector<int>& initialVector);
 
-    int getNodesCount() const;
-    float getHeuristicAverage() const;
+    uint64_t getNodesCount() const;
+    double getHeuristicAverage() const;
     int getStartHeuristic() const;
+    size_t getClosedSetBytes() const;
+    const SearchStats& getStats() const; // Contadores da última busca
+
+    void usePatternDatabase(const AdditivePDB* _pdb); // Troca a heurística pelo banco de padrões
+    void setHeuristic(HeuristicType type); // Troca a heurística usada nas próximas buscas
 
 private:
-    std::vector<int> finalVector;
-    int nodesCount;
-    float heuristicSum;
+    PuzzleState finalState;
+    Heuristic heuristic; // Heurística escolhida (Manhattan por padrão) para o estado final
+    SearchStats stats;
+    double heuristicSum;
     int startHeuristic;
+    size_t closedSetBytes; // Memória usada pelo conjunto fechado na última busca
+    NodeStore nodes; // Nós da busca atual, reaproveitados entre chamadas de findSolution
+    BucketQueue<AstarNode> openList; // Lista aberta e conjunto fechado, esvaziados a cada busca
+    StateMap<int> closedSet; // sem perder a memória já alocada; guarda o g da expansão, para
+                             // reabrir estados com o banco de padrões (não consistente)
+    std::vector<Node> solutionNodes; // Caminho da última solução
 
-    int manhattanDistance(const std::vector<int>& state, const std::vector<int>& goal);
-    std::vector<Node*> tracePath(Node* node);
+    template <typename Domain>
+    std::vector<Node*> search(const PuzzleState& initialState); // Laço do A*, instanciado por tamanho de tabuleiro
+    std::vector<Node*> tracePath(uint32_t node);
+    void finishStats(); // Registra a memória e o conjunto fechado ao fim da busca
 };
 
 #endif // ASTAR_H
@@ -1,21 +1,16 @@
 #ifndef ASTARNODE_H
 #define ASTARNODE_H
 
-#include "node.h"
+#include <cstdint>
 
+// Entrada da lista aberta do A*: índice do nó no NodeStore e seus custos
 class AstarNode {
 public:
-    Node* node;
+    uint32_t node;
     int gCost;
     int hCost;
-    int fCost;
-    std::vector<Node*> children;
 
-    AstarNode(Node* _node, int _gCost, int _hCost, int _fCost);
-};
-
-struct AstarComparator {
-    bool operator()(const AstarNode& a, const AstarNode& b) const;
+    AstarNode(uint32_t _node, int _gCost, int _hCost);
 };
 
 #endif // ASTARNODE_H
@@ -0,0 +1,187 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Resolve count instâncias independentes com um conjunto fixo de threads. As instâncias
+// são distribuídas dinamicamente, das mais difíceis (maior cost) para as mais fáceis,
+// para que uma instância longa não fique sozinha no fim do lote. solve(i) devolve o
+// resultado da instância i; a thread principal passa os resultados para emit na ordem
+// de entrada, assim que todos os anteriores estiverem prontos.
+template <typename Solve, typename Emit>
+void runBatch(size_t count, int threads, const std::vector<int>& cost, Solve solve, Emit emit) {
+    typedef decltype(solve(size_t())) Result;
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return cost[a] > cost[b]; });
+
+    std::vector<Result> results(count);
+    std::vector<char> ready(count, 0);
+    std::mutex readyMutex;
+    std::condition_variable readyChanged;
+    std::atomic<size_t> cursor(0);
+
+    auto worker = [&]() {
+        while (true) {
+            size_t next = cursor.fetch_add(1);
+            if (next >= count) {
+                break;
+            }
+            size_t index = order[next];
+            Result result = solve(index);
+            std::lock_guard<std::mutex> lock(readyMutex);
+            results[index] = std::move(result);
+            ready[index] = 1;
+            readyChanged.notify_one();
+        }
+    };
+
+    threads = std::max(1, std::min(threads, static_cast<int>(count)));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+
+    // A thread principal só escreve: espera cada resultado na ordem de entrada
+    for (size_t index = 0; index < count; ++index) {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        readyChanged.wait(lock, [&]() { return ready[index] != 0; });
+        Result result = std::move(results[index]);
+        lock.unlock();
+        emit(result);
+    }
+
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+// Fila de capacidade limitada entre um produtor e vários consumidores: push espera
+// enquanto a fila está cheia e pop espera enquanto ela está vazia. Depois de close, pop
+// esvazia o que restou e então retorna false.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t _capacity) : capacity(std::max<size_t>(1, _capacity)), closed(false) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&]() { return items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&]() { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    bool closed;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+};
+
+// Versão em fluxo de runBatch, para quando as instâncias chegam aos poucos: uma thread lê
+// com read(item) (false no fim da entrada) e alimenta uma BoundedQueue de capacity itens,
+// e as threads de trabalho começam a resolver assim que a primeira instância é lida. Sem
+// conhecer o lote inteiro não há como ordenar pela dificuldade, então as instâncias são
+// resolvidas na ordem de chegada. Os resultados vão para emit na ordem de entrada, como
+// em runBatch. A leitura também espera enquanto há capacity instâncias lidas e ainda não
+// escritas, para que uma instância lenta não deixe os resultados seguintes acumularem
+// sem limite. Retorna o número de instâncias resolvidas.
+template <typename T, typename Read, typename Solve, typename Emit>
+size_t runStream(Read read, int threads, size_t capacity, Solve solve, Emit emit) {
+    typedef decltype(solve(std::declval<const T&>())) Result;
+    BoundedQueue<std::pair<size_t, T>> queue(capacity);
+    const size_t window = std::max<size_t>(1, capacity); // Como a fila, ao menos uma instância
+    std::map<size_t, Result> results; // Resultados prontos que ainda esperam os anteriores
+    std::mutex readyMutex;
+    std::condition_variable readyChanged;
+    std::condition_variable windowChanged;
+    size_t nextEmit = 0; // Próxima instância a escrever
+    size_t total = 0; // Instâncias lidas
+    bool readDone = false;
+
+    std::thread reader([&]() {
+        T item;
+        size_t index = 0;
+        while (read(item)) {
+            {
+                // Janela de reordenação: no máximo capacity instâncias entre a leitura e a escrita
+                std::unique_lock<std::mutex> lock(readyMutex);
+                windowChanged.wait(lock, [&]() { return index - nextEmit < window; });
+            }
+            queue.push(std::make_pair(index++, item));
+        }
+        queue.close();
+        std::lock_guard<std::mutex> lock(readyMutex);
+        total = index;
+        readDone = true;
+        readyChanged.notify_one();
+    });
+
+    auto worker = [&]() {
+        std::pair<size_t, T> next;
+        while (queue.pop(next)) {
+            Result result = solve(next.second);
+            std::lock_guard<std::mutex> lock(readyMutex);
+            results[next.first] = std::move(result);
+            readyChanged.notify_one();
+        }
+    };
+
+    threads = std::max(1, threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+
+    // A thread principal só escreve: espera cada linha na ordem de entrada até o fim da leitura
+    for (size_t index = 0;; ++index) {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        readyChanged.wait(lock, [&]() { return results.count(index) != 0 || (readDone && index == total); });
+        if (readDone && index == total) {
+            break;
+        }
+        Result result = std::move(results[index]);
+        results.erase(index);
+        nextEmit = index + 1;
+        lock.unlock();
+        windowChanged.notify_one();
+        emit(result);
+    }
+
+    reader.join();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    return total;
+}
+
+#endif // BATCH_H
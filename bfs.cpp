@@ -1,13 +1,14 @@
 #include "bfs.h" // Inclui o cabeçalho contendo a declaração da classe BFS
 #include <algorithm> // Para usar std::reverse para reverter um vetor
+#include <climits>
 
 BFS::BFS(const std::vector<int>& finalVector) 
-    : finalVector(finalVector), nodesCount(0), solutionDepth(0) {} 
+    : finalState(finalVector), solutionDepth(0), bidirectional(false) {} 
 // Construtor da classe BFS. Recebe um vetor que representa o estado final 
-// e inicializa os atributos `nodesCount` e `solutionDepth` com zero.
+// e inicializa `solutionDepth` com zero (as estatísticas começam zeradas).
 
-int BFS::getNodesCount() const { 
-    return nodesCount; 
+uint64_t BFS::getNodesCount() const { 
+    return stats.expanded; 
 }
 // Função para retornar a contagem total de nós visitados durante a busca.
 
@@ -16,53 +17,154 @@ int BFS::getSolutionDepth() const {
 }
 // Função para retornar a profundidade da solução encontrada.
 
-std::vector<Node*> BFS::traceSolution(Node* node) { 
-    std::vector<Node*> path; // Cria um vetor para armazenar o caminho da solução
-    while (node) { // Enquanto houver um nó válido
-        path.push_back(node); // Adiciona o nó atual ao caminho
-        node = node->parent; // Segue para o nó pai
+void BFS::setBidirectional(bool enabled) {
+    bidirectional = enabled;
+}
+
+const SearchStats& BFS::getStats() const {
+    return stats;
+}
+
+// A fila nunca passa de peakOpen estados; os visitados só crescem até o fim da busca
+void BFS::finishStats(size_t visited, size_t bytes) {
+    stats.noteClosed(visited);
+    stats.noteBytes(bytes + stats.peakOpen * sizeof(PuzzleState));
+}
+
+// Acrescenta a states o caminho de state até a raiz da busca, desfazendo os movimentos
+// guardados; retorna o número de movimentos
+static int walkToRoot(const BFSNode& bfsNode, PuzzleState state, std::vector<PuzzleState>& states) {
+    int steps = 0;
+    states.push_back(state);
+    int move;
+    while ((move = bfsNode.moveInto(state)) != MOVE_NONE) { // Até chegar à raiz
+        state = state.moved(state.target(inverseMove(move))); // Desfaz o movimento
+        states.push_back(state);
+        steps++;
     }
-    std::reverse(path.begin(), path.end()); // Inverte o vetor para ter o caminho na ordem correta
-    return path; // Retorna o caminho completo
+    return steps;
+}
+
+std::vector<Node*> BFS::makePath(const std::vector<PuzzleState>& states) {
+    std::vector<Node*> path = linkPath(states, solutionNodes);
+    solutionDepth = static_cast<int>(path.size()); 
+    return path;
+}
+
+std::vector<Node*> BFS::traceSolution(const BFSNode& bfsNode, const PuzzleState& parent, const PuzzleState& goal) { 
+    std::vector<PuzzleState> states; // Estados do caminho, do último para o primeiro
+    states.push_back(goal); // O objetivo não chega a ser marcado como visitado
+    walkToRoot(bfsNode, parent, states);
+    std::reverse(states.begin(), states.end()); // Inverte o vetor para ter o caminho na ordem correta
+    return makePath(states); // Retorna o caminho completo
 }
 
 std::vector<Node*> BFS::solve(const std::vector<int>& initialVector) { 
-    Node* initialNode = new Node(initialVector, nullptr, 1); 
-    // Cria um nó inicial usando o vetor inicial, sem pai, e com profundidade 1
-    
-    BFSNode bfsNode(initialNode); 
-    // Cria um objeto auxiliar para a BFS, a partir do nó inicial
+    stats.reset();
+    solutionDepth = 0;
+    if (bidirectional) {
+        return solveBidirectional(PuzzleState(initialVector));
+    }
+
+    BFSNode bfsNode{PuzzleState(initialVector)}; 
+    // Cria a fila e o conjunto de visitados a partir do estado inicial
 
     std::vector<Node*> solutionPath; // Cria um vetor para armazenar o caminho da solução encontrada
+    PuzzleState current;
     
-    // Enquanto houver nós para visitar
-    while (Node* currentNode = bfsNode.getNextNode()) { 
-        currentNode->moveUp(1); // Move para cima (ou tenta, com valor 1)
-        currentNode->moveLeft(1); // Move para a esquerda
-        currentNode->moveRight(1); // Move para a direita
-        currentNode->moveDown(1); // Move para baixo
-
-        nodesCount++; // Incrementa a contagem de nós visitados
-
-        // Para cada nó filho gerado a partir do nó atual
-        for (Node* child : currentNode->children) {
-            // Se um nó filho tiver o vetor igual ao vetor final, encontrou-se a solução
-            if (child->initialVector == finalVector) { 
-                solutionPath = traceSolution(child); 
-                // Traça o caminho de volta para obter a solução
-                solutionDepth = static_cast<int>(solutionPath.size()); 
-                // Define a profundidade da solução encontrada
+    // Enquanto houver estados para visitar
+    while (bfsNode.getNextNode(current)) { 
+        stats.expanded++; // Incrementa a contagem de nós visitados
+
+        // Percorre os filhos na ordem cima, esquerda, direita, baixo
+        for (const Successor& next : Successors(current)) {
+            PuzzleState child = next.state();
+
+            // Se um filho tiver o estado igual ao estado final, encontrou-se a solução
+            if (child == finalState) { 
+                finishStats(bfsNode.visitedCount(), bfsNode.bytesUsed());
+                solutionPath = traceSolution(bfsNode, current, child); // Refaz o caminho pelos movimentos guardados
                 return solutionPath; // Retorna o caminho da solução
             }
 
-            // Se o vetor do filho não foi visitado antes
-            if (!bfsNode.isVisited(child->initialVector)) { 
-                bfsNode.addNode(child); // Adiciona o nó ao BFSNode para futura visita
-                bfsNode.setVisited(child->initialVector); 
-                // Marca este vetor como visitado
+            // Se o filho não foi visitado antes
+            if (!bfsNode.isVisited(child)) { 
+                bfsNode.addNode(child, next.move); // Marca como visitado e enfileira para futura visita
+                stats.generated++;
+            } else {
+                stats.duplicates++;
             }
         }
+        stats.noteOpen(bfsNode.openList.size());
     }
 
+    finishStats(bfsNode.visitedCount(), bfsNode.bytesUsed());
     return {}; // Se nenhum caminho foi encontrado, retorna um vetor vazio
 }
+
+// Cada passo expande uma camada inteira da fronteira menor. Ao fim da primeira camada em
+// que algum filho já foi visitado pelo outro lado, o menor encontro da camada é ótimo:
+// todo caminho mais curto teria sido detectado ao expandir uma camada anterior.
+std::vector<Node*> BFS::solveBidirectional(const PuzzleState& initialState) {
+    if (initialState == finalState) {
+        return makePath({ initialState });
+    }
+    BFSNode forward{initialState}; // Visitados a partir do início
+    BFSNode backward{finalState}; // Visitados a partir do objetivo
+    int forwardDepth = 0; // Profundidade da camada na fila de cada lado
+    int backwardDepth = 0;
+
+    while (!forward.openList.empty() && !backward.openList.empty()) {
+        bool growForward = forward.openList.size() <= backward.openList.size();
+        BFSNode& side = growForward ? forward : backward;
+        BFSNode& other = growForward ? backward : forward;
+        int& depth = growForward ? forwardDepth : backwardDepth;
+
+        int best = INT_MAX; // Comprimento do melhor encontro nesta camada
+        PuzzleState meetParent; // Estado expandido e filho que já estava do outro lado
+        PuzzleState meetChild;
+        std::vector<PuzzleState> scratch;
+        size_t layer = side.openList.size();
+        PuzzleState current;
+        for (size_t i = 0; i < layer; ++i) {
+            side.getNextNode(current);
+            stats.expanded++;
+            for (const Successor& next : Successors(current)) {
+                PuzzleState child = next.state();
+                if (other.isVisited(child)) {
+                    scratch.clear();
+                    int length = depth + 1 + walkToRoot(other, child, scratch);
+                    if (length < best) {
+                        best = length;
+                        meetParent = current;
+                        meetChild = child;
+                    }
+                    continue;
+                }
+                if (!side.isVisited(child)) {
+                    side.addNode(child, next.move);
+                    stats.generated++;
+                } else {
+                    stats.duplicates++;
+                }
+            }
+            stats.noteOpen(forward.openList.size() + backward.openList.size());
+        }
+        depth++;
+
+        if (best != INT_MAX) {
+            finishStats(forward.visitedCount() + backward.visitedCount(), forward.bytesUsed() + backward.bytesUsed());
+            // Início até o estado do lado de frente, depois o estado do lado de trás até o objetivo
+            const PuzzleState& front = growForward ? meetParent : meetChild;
+            const PuzzleState& back = growForward ? meetChild : meetParent;
+            std::vector<PuzzleState> states;
+            walkToRoot(forward, front, states);
+            std::reverse(states.begin(), states.end());
+            walkToRoot(backward, back, states);
+            return makePath(states);
+        }
+    }
+
+    finishStats(forward.visitedCount() + backward.visitedCount(), forward.bytesUsed() + backward.bytesUsed());
+    return {}; // As fronteiras não se encontraram: o objetivo é inalcançável
+}
@@ -3,9 +3,11 @@
 
 #include "bfsnode.h"
 #include "node.h"
+#include "nodestore.h"
+#include "successors.h"
+#include "searchstats.h"
 #include <vector>
 #include <queue>
-#include <unordered_set>
 #include <string>
 #include <algorithm>
 
@@ -15,15 +17,25 @@ public:
 
     std::vector<Node*> solve(const std::vector<int>& initialVector);
 
-    int getNodesCount() const;
+    // Busca bidirecional: cresce a menor entre a fronteira do início e a do objetivo,
+    // uma camada por vez, até que elas se encontrem
+    void setBidirectional(bool enabled);
+
+    uint64_t getNodesCount() const;
     int getSolutionDepth() const;
+    const SearchStats& getStats() const; // Contadores da última busca
 
 private:
-    std::vector<int> finalVector;
-    int nodesCount;
+    PuzzleState finalState;
+    SearchStats stats;
     int solutionDepth;
+    bool bidirectional;
+    std::vector<Node> solutionNodes; // Caminho da última solução
 	//std::vector<Node*> solve(const std::vector<int>& initialVector);
-    std::vector<Node*> traceSolution(Node* node);
+    std::vector<Node*> traceSolution(const BFSNode& bfsNode, const PuzzleState& parent, const PuzzleState& goal);
+    std::vector<Node*> solveBidirectional(const PuzzleState& initialState);
+    std::vector<Node*> makePath(const std::vector<PuzzleState>& states); // Copia os estados para solutionNodes
+    void finishStats(size_t visited, size_t bytes); // Registra os visitados e a memória no pico
 };
 
 #endif // BFS_H
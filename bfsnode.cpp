@@ -1,27 +1,58 @@
 #include "bfsnode.h"
 
-BFSNode::BFSNode(Node* initialNode) {
-    openList.push(initialNode);
-    visited[initialNode->initialVector] = true;
+const int BFSNode::MAX_RANKED_CELLS;
+const uint8_t BFSNode::NOT_VISITED; // Usado por referência em moves.assign
+
+BFSNode::BFSNode(const PuzzleState& initialState) : ranked(initialState.cells <= MAX_RANKED_CELLS), visited(0) {
+    if (ranked) {
+        moves.assign(boardCount(initialState.cells), NOT_VISITED);
+    }
+    addNode(initialState, MOVE_NONE);
 }
 
-void BFSNode::addNode(Node* node) {
-    openList.push(node);
+uint8_t* BFSNode::slot(const PuzzleState& state) {
+    if (ranked) {
+        return &moves[rankBoard(state.tiles, state.cells)];
+    }
+    bool inserted;
+    uint8_t& move = movesByKey.insert(state.key(), inserted);
+    if (inserted) {
+        move = NOT_VISITED;
+    }
+    return &move;
 }
 
-Node* BFSNode::getNextNode() {
+const uint8_t* BFSNode::slot(const PuzzleState& state) const {
+    if (ranked) {
+        return &moves[rankBoard(state.tiles, state.cells)];
+    }
+    return movesByKey.find(state.key());
+}
+
+void BFSNode::addNode(const PuzzleState& state, int move) {
+    *slot(state) = static_cast<uint8_t>(move);
+    visited++;
+    openList.push(state);
+}
+
+bool BFSNode::getNextNode(PuzzleState& state) {
     if (openList.empty()) {
-        return nullptr;
+        return false;
     }
-    Node* nextNode = openList.front();
+    state = openList.front();
     openList.pop();
-    return nextNode;
+    return true;
+}
+
+bool BFSNode::isVisited(const PuzzleState& state) const {
+    const uint8_t* move = slot(state);
+    return move && *move != NOT_VISITED;
 }
 
-bool BFSNode::isVisited(const std::vector<int>& state) {
-    return visited.count(state) > 0;
+int BFSNode::moveInto(const PuzzleState& state) const {
+    return *slot(state);
 }
 
-void BFSNode::setVisited(const std::vector<int>& state) {
-    visited[state] = true;
+size_t BFSNode::bytesUsed() const {
+    return moves.capacity() + movesByKey.bytesUsed();
 }
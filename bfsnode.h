@@ -1,22 +1,42 @@
 #ifndef BFSNODE_H
 #define BFSNODE_H
 
-#include "node.h"
+#include "puzzlestate.h"
+#include "stateset.h"
+#include "permutation.h"
 #include <queue>
-#include <map>
 #include <vector>
 
+// Fronteira e estados visitados da BFS. Para tabuleiros de até 9 posições (8-puzzle) o
+// estado é ranqueado entre os 9!/2 de mesma paridade e o movimento que levou a ele fica
+// num vetor de bytes indexado pelo posto (181.440 bytes); tabuleiros maiores não cabem
+// num vetor denso e usam um mapa por hash da chave compactada.
 class BFSNode {
 public:
-    std::queue<Node*> openList; // Fila para os nós abertos (em busca)
-    std::map<std::vector<int>, bool> visited; // Conjunto de estados já visitados
+    static const int MAX_RANKED_CELLS = 9; // Maior tabuleiro indexado pelo posto
+    static const uint8_t NOT_VISITED = 0xFF;
 
-    BFSNode(Node* initialNode);
+    std::queue<PuzzleState> openList; // Fila para os estados abertos (em busca)
 
-    void addNode(Node* node);
-    Node* getNextNode();
-    bool isVisited(const std::vector<int>& state);
-    void setVisited(const std::vector<int>& state);
+    explicit BFSNode(const PuzzleState& initialState);
+
+    // Marca o estado como visitado, guardando o movimento que levou a ele, e o enfileira
+    void addNode(const PuzzleState& state, int move);
+    bool getNextNode(PuzzleState& state);
+    bool isVisited(const PuzzleState& state) const;
+    int moveInto(const PuzzleState& state) const; // MOVE_NONE na raiz
+
+    size_t visitedCount() const { return visited; }
+    size_t bytesUsed() const; // Memória dos visitados, em bytes (sem a fila)
+
+private:
+    bool ranked; // Visitados indexados pelo posto (true) ou pelo hash da chave
+    std::vector<uint8_t> moves; // Movimento que levou a cada posto (NOT_VISITED se não visitado)
+    StateMap<uint8_t> movesByKey; // O mesmo, para tabuleiros maiores
+    size_t visited; // Estados marcados como visitados
+
+    uint8_t* slot(const PuzzleState& state);
+    const uint8_t* slot(const PuzzleState& state) const;
 };
 
 #endif // BFSNODE_H
@@ -0,0 +1,289 @@
+#include "binaryformat.h"
+#include "instancereader.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+// Formato das instâncias:
+//   "PZI1", cells (1 byte), largura (1 byte), 2 bytes reservados,
+//   e em seguida 8 bytes por instância: as peças compactadas como em PuzzleState::tiles.
+// Formato dos resultados:
+//   "PZR1", cells (1 byte), largura (1 byte), 2 bytes reservados,
+//   capacidade de movimentos (4 bytes), tamanho do registro (4 bytes),
+//   e em seguida um registro por instância: nós expandidos (8 bytes), tempo em segundos
+//   (double, 8 bytes), comprimento (4 bytes, -1 sem solução), flags (4 bytes) e os
+//   movimentos com 2 bits cada, 4 por byte, a partir dos bits baixos.
+const char INSTANCE_MAGIC[4] = { 'P', 'Z', 'I', '1' };
+const char RESULT_MAGIC[4] = { 'P', 'Z', 'R', '1' };
+static const size_t RESULT_FIXED_SIZE = 24; // Bytes do registro antes dos movimentos
+
+BufferedWriter::BufferedWriter() : stream(nullptr), ownsStream(false), failed(false), used(0) {}
+
+BufferedWriter::~BufferedWriter() {
+    close();
+}
+
+bool BufferedWriter::open(const std::string& path) {
+    close();
+    failed = false;
+    if (path == "-") {
+        stream = stdout;
+    } else {
+        stream = std::fopen(path.c_str(), "wb");
+        ownsStream = true;
+        if (!stream) {
+            ownsStream = false;
+            return false;
+        }
+    }
+    buffer.resize(BUFFER_SIZE);
+    used = 0;
+    return true;
+}
+
+void BufferedWriter::write(const void* data, size_t size) {
+    if (!stream) {
+        failed = true;
+        return;
+    }
+    if (used + size > buffer.size()) {
+        flush();
+        if (size > buffer.size()) { // Bloco maior que o buffer: vai direto para o arquivo
+            failed |= std::fwrite(data, 1, size, stream) != size;
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+bool BufferedWriter::flush() {
+    if (!stream) {
+        return false;
+    }
+    if (used > 0) {
+        failed |= std::fwrite(buffer.data(), 1, used, stream) != used;
+        used = 0;
+    }
+    failed |= std::fflush(stream) != 0;
+    return !failed;
+}
+
+bool BufferedWriter::close() {
+    if (!stream) {
+        return !failed;
+    }
+    flush();
+    if (ownsStream) {
+        failed |= std::fclose(stream) != 0;
+    }
+    stream = nullptr;
+    ownsStream = false;
+    return !failed;
+}
+
+InstanceWriter::InstanceWriter() : cells(0), written(0) {}
+
+bool InstanceWriter::open(const std::string& path) {
+    cells = 0;
+    written = 0;
+    return out.open(path);
+}
+
+bool InstanceWriter::write(const PuzzleState& state) {
+    if (written == 0) {
+        unsigned char header[INSTANCE_HEADER_SIZE] = {};
+        std::memcpy(header, INSTANCE_MAGIC, 4);
+        header[4] = state.cells;
+        header[5] = state.width;
+        out.write(header, INSTANCE_HEADER_SIZE);
+        cells = state.cells;
+    } else if (state.cells != cells) {
+        return false;
+    }
+    out.write(&state.tiles, INSTANCE_RECORD_SIZE);
+    written++;
+    return true;
+}
+
+bool InstanceWriter::close() {
+    if (written == 0) { // Lote vazio: só o cabeçalho, sem tamanho de tabuleiro
+        unsigned char header[INSTANCE_HEADER_SIZE] = {};
+        std::memcpy(header, INSTANCE_MAGIC, 4);
+        out.write(header, INSTANCE_HEADER_SIZE);
+    }
+    return out.close();
+}
+
+ResultWriter::ResultWriter() : moveCapacity(DEFAULT_MOVE_CAPACITY), written(0) {}
+
+bool ResultWriter::open(const std::string& path, int cells, int width, int _moveCapacity) {
+    moveCapacity = (std::max(_moveCapacity, 1) + 31) / 32 * 32;
+    written = 0;
+    record.assign(RESULT_FIXED_SIZE + static_cast<size_t>(moveCapacity) / 4, 0);
+    if (!out.open(path)) {
+        return false;
+    }
+    unsigned char header[RESULT_HEADER_SIZE] = {};
+    std::memcpy(header, RESULT_MAGIC, 4);
+    header[4] = static_cast<unsigned char>(cells);
+    header[5] = static_cast<unsigned char>(width);
+    uint32_t capacity = static_cast<uint32_t>(moveCapacity);
+    uint32_t recordSize = static_cast<uint32_t>(record.size());
+    std::memcpy(header + 8, &capacity, 4);
+    std::memcpy(header + 12, &recordSize, 4);
+    out.write(header, RESULT_HEADER_SIZE);
+    return true;
+}
+
+void ResultWriter::write(const ResultRecord& result) {
+    std::fill(record.begin(), record.end(), 0);
+    uint32_t flags = result.flags;
+    if (result.moves.size() > static_cast<size_t>(moveCapacity)) {
+        flags &= ~ResultRecord::HAS_MOVES; // Não cabe: grava só o comprimento
+    }
+    std::memcpy(record.data(), &result.nodes, 8);
+    std::memcpy(record.data() + 8, &result.seconds, 8);
+    std::memcpy(record.data() + 16, &result.length, 4);
+    std::memcpy(record.data() + 20, &flags, 4);
+    if (flags & ResultRecord::HAS_MOVES) {
+        unsigned char* moves = record.data() + RESULT_FIXED_SIZE;
+        for (size_t i = 0; i < result.moves.size(); ++i) {
+            moves[i / 4] |= static_cast<unsigned char>((result.moves[i] & 3) << (2 * (i % 4)));
+        }
+    }
+    out.write(record.data(), record.size());
+    written++;
+}
+
+bool ResultWriter::close() {
+    return out.close();
+}
+
+ResultFile::ResultFile() : records(0), recordSize(0), moveCapacity(0), cells(0), width(0) {}
+
+bool ResultFile::open(const std::string& path) {
+    records = 0;
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* data = file.data();
+    if (file.size() < RESULT_HEADER_SIZE || std::memcmp(data, RESULT_MAGIC, 4) != 0) {
+        file.close();
+        return false;
+    }
+    uint32_t capacity;
+    uint32_t size;
+    std::memcpy(&capacity, data + 8, 4);
+    std::memcpy(&size, data + 12, 4);
+    if (size != RESULT_FIXED_SIZE + capacity / 4 || (file.size() - RESULT_HEADER_SIZE) % size != 0) {
+        file.close();
+        return false;
+    }
+    cells = data[4];
+    width = data[5];
+    moveCapacity = static_cast<int>(capacity);
+    recordSize = size;
+    records = (file.size() - RESULT_HEADER_SIZE) / size;
+    return true;
+}
+
+ResultRecord ResultFile::record(size_t index) const {
+    const unsigned char* data = file.data() + RESULT_HEADER_SIZE + index * recordSize;
+    ResultRecord result;
+    std::memcpy(&result.nodes, data, 8);
+    std::memcpy(&result.seconds, data + 8, 8);
+    std::memcpy(&result.length, data + 16, 4);
+    std::memcpy(&result.flags, data + 20, 4);
+    if ((result.flags & ResultRecord::HAS_MOVES) && result.length > 0 && result.length <= moveCapacity) {
+        const unsigned char* moves = data + RESULT_FIXED_SIZE;
+        result.moves.resize(static_cast<size_t>(result.length));
+        for (size_t i = 0; i < result.moves.size(); ++i) {
+            result.moves[i] = static_cast<uint8_t>((moves[i / 4] >> (2 * (i % 4))) & 3);
+        }
+    }
+    return result;
+}
+
+// Resultados binários para texto, uma linha por instância
+static bool convertResults(const ResultFile& results, const std::string& outputPath, std::ostream& log) {
+    static const char MOVE_LETTERS[4] = { 'U', 'L', 'R', 'D' };
+    BufferedWriter out;
+    if (!out.open(outputPath)) {
+        log << "Erro ao criar " << outputPath << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < results.count(); ++i) {
+        ResultRecord result = results.record(i);
+        std::ostringstream line;
+        line << result.nodes << ", " << result.length << ", " << result.seconds << ", ";
+        if (result.flags & ResultRecord::HAS_MOVES) {
+            for (uint8_t move : result.moves) {
+                line << MOVE_LETTERS[move];
+            }
+        } else {
+            line << '-';
+        }
+        line << '\n';
+        out.write(line.str());
+    }
+    log << results.count() << " resultados convertidos para texto" << std::endl;
+    return out.close();
+}
+
+bool convertFile(const std::string& inputPath, const std::string& outputPath, std::ostream& log) {
+    ResultFile results;
+    if (inputPath != "-" && results.open(inputPath)) {
+        return convertResults(results, outputPath, log);
+    }
+
+    InstanceReader reader;
+    if (!reader.open(inputPath)) {
+        log << "Erro ao abrir o arquivo de entrada " << inputPath << std::endl;
+        return false;
+    }
+    size_t count = 0;
+    size_t skipped = 0; // Tamanho diferente das instâncias anteriores
+    bool ok;
+    PuzzleState state;
+    if (reader.isBinary()) { // Binário para texto: as peças separadas por espaços
+        BufferedWriter out;
+        if (!out.open(outputPath)) {
+            log << "Erro ao criar " << outputPath << std::endl;
+            return false;
+        }
+        while (reader.next(state)) {
+            std::string line;
+            for (int i = 0; i < state.cells; ++i) {
+                if (i > 0) {
+                    line += ' ';
+                }
+                line += std::to_string(state.at(i));
+            }
+            line += '\n';
+            out.write(line);
+            count++;
+        }
+        ok = out.close();
+    } else { // Texto para binário
+        InstanceWriter out;
+        if (!out.open(outputPath)) {
+            log << "Erro ao criar " << outputPath << std::endl;
+            return false;
+        }
+        while (reader.next(state)) {
+            if (out.write(state)) {
+                count++;
+            } else {
+                skipped++;
+            }
+        }
+        ok = out.close();
+    }
+    log << count << " instâncias convertidas para " << (reader.isBinary() ? "texto" : "binário");
+    if (reader.errors() + skipped > 0) {
+        log << ", " << reader.errors() + skipped << " ignoradas";
+    }
+    log << std::endl;
+    return ok;
+}
@@ -0,0 +1,162 @@
+#ifndef BINARYFORMAT_H
+#define BINARYFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "puzzlestate.h"
+#include "mappedfile.h"
+
+// Formatos binários versionados para lotes grandes (little-endian, ver binaryformat.cpp):
+// instâncias com 8 bytes cada (o estado compactado) e resultados em registros de tamanho
+// fixo, que podem ser mapeados com mmap e acessados pelo índice da instância.
+
+extern const char INSTANCE_MAGIC[4]; // "PZI1"
+extern const char RESULT_MAGIC[4]; // "PZR1"
+const size_t INSTANCE_HEADER_SIZE = 8;
+const size_t INSTANCE_RECORD_SIZE = 8;
+const size_t RESULT_HEADER_SIZE = 16;
+
+// Escrita com um buffer próprio: os dados só vão para o arquivo quando o buffer enche ou
+// em flush/close, em vez de uma chamada ao sistema por linha
+class BufferedWriter {
+public:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    BufferedWriter();
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool open(const std::string& path); // "-" é a saída padrão
+    void write(const void* data, size_t size);
+    void write(const std::string& text) { write(text.data(), text.size()); }
+    bool flush();
+    bool close(); // Retorna false se alguma escrita falhou
+
+private:
+    std::FILE* stream;
+    bool ownsStream;
+    bool failed;
+    std::vector<char> buffer;
+    size_t used;
+};
+
+// Resultado de uma instância: nós expandidos, comprimento (-1 sem solução), tempo e os
+// movimentos do zero (ver Move) do início ao objetivo
+struct ResultRecord {
+    static const uint32_t SOLVED = 1; // Há solução
+    static const uint32_t HAS_MOVES = 2; // Os movimentos cabem no registro e foram gravados
+
+    uint64_t nodes;
+    double seconds;
+    int32_t length;
+    uint32_t flags;
+    std::vector<uint8_t> moves;
+
+    ResultRecord() : nodes(0), seconds(0), length(-1), flags(0) {}
+};
+
+// Estado de cada elemento de um caminho, seja ele um estado ou um ponteiro para nó
+inline const PuzzleState& pathState(const PuzzleState& state) { return state; }
+template <typename T>
+const PuzzleState& pathState(const T* node) { return node->state; }
+
+// Movimento do zero que leva de from a to (estados vizinhos)
+inline uint8_t moveBetween(const PuzzleState& from, const PuzzleState& to) {
+    int delta = static_cast<int>(to.zero) - static_cast<int>(from.zero);
+    if (delta == -static_cast<int>(from.width)) {
+        return MOVE_UP;
+    }
+    if (delta == -1) {
+        return MOVE_LEFT;
+    }
+    if (delta == 1) {
+        return MOVE_RIGHT;
+    }
+    return MOVE_DOWN;
+}
+
+// Monta o resultado a partir do caminho devolvido por um dos algoritmos (vazio se não
+// houver solução)
+template <typename Path>
+ResultRecord makeResult(uint64_t nodes, double seconds, const Path& path) {
+    ResultRecord result;
+    result.nodes = nodes;
+    result.seconds = seconds;
+    if (!path.empty()) {
+        result.length = static_cast<int32_t>(path.size() - 1);
+        result.flags = ResultRecord::SOLVED | ResultRecord::HAS_MOVES;
+        for (size_t i = 1; i < path.size(); ++i) {
+            result.moves.push_back(moveBetween(pathState(path[i - 1]), pathState(path[i])));
+        }
+    }
+    return result;
+}
+
+// Arquivo de instâncias: cabeçalho seguido de um estado compactado por instância
+class InstanceWriter {
+public:
+    InstanceWriter();
+
+    bool open(const std::string& path);
+    bool write(const PuzzleState& state); // false se o tamanho diferir das anteriores
+    bool close();
+    size_t count() const { return written; }
+
+private:
+    BufferedWriter out;
+    int cells; // Definido pela primeira instância, que também grava o cabeçalho
+    size_t written;
+};
+
+// Arquivo de resultados: cabeçalho seguido de um registro de tamanho fixo por instância,
+// na ordem de entrada. Soluções maiores que moveCapacity ficam sem os movimentos.
+class ResultWriter {
+public:
+    static const int DEFAULT_MOVE_CAPACITY = 256;
+
+    ResultWriter();
+
+    bool open(const std::string& path, int cells, int width, int moveCapacity = DEFAULT_MOVE_CAPACITY);
+    void write(const ResultRecord& result);
+    bool close();
+    size_t count() const { return written; }
+
+private:
+    BufferedWriter out;
+    int moveCapacity; // Múltiplo de 32, para que os registros fiquem alinhados em 8 bytes
+    size_t written;
+    std::vector<unsigned char> record;
+};
+
+// Leitura de um arquivo de resultados mapeado em memória
+class ResultFile {
+public:
+    ResultFile();
+
+    bool open(const std::string& path); // false se não for um arquivo de resultados válido
+    size_t count() const { return records; }
+    int getCells() const { return cells; }
+    int getWidth() const { return width; }
+    ResultRecord record(size_t index) const;
+
+private:
+    MappedFile file;
+    size_t records;
+    size_t recordSize;
+    int moveCapacity;
+    int cells;
+    int width;
+};
+
+// Converte entre texto e binário, na direção dada pelo formato da entrada: instâncias em
+// texto viram binárias e vice-versa; resultados binários viram texto ("nós, comprimento,
+// tempo, movimentos" com os movimentos em letras U, L, R e D). Mensagens vão para log.
+bool convertFile(const std::string& inputPath, const std::string& outputPath, std::ostream& log);
+
+#endif // BINARYFORMAT_H
@@ -0,0 +1,96 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <cstddef>
+#include <vector>
+
+// Fila de prioridade por baldes para custos inteiros pequenos. O primeiro nível é
+// indexado pela chave principal (menor primeiro) e o segundo pela chave secundária;
+// dentro de um balde a retirada é LIFO, o que reproduz o desempate pela ordem de
+// inserção mais recente, já que os nós entram na fila em ordem crescente de inserção.
+template <typename T>
+class BucketQueue {
+public:
+    // Se highSecondaryFirst for verdadeiro, a maior chave secundária sai primeiro
+    explicit BucketQueue(bool _highSecondaryFirst = false)
+        : highSecondaryFirst(_highSecondaryFirst), count(0), minPrimary(0) {}
+
+    void push(int primary, int secondary, const T& item) {
+        if (primary >= static_cast<int>(levels.size())) {
+            levels.resize(primary + 1);
+        }
+        Level& level = levels[primary];
+        if (secondary >= static_cast<int>(level.stacks.size())) {
+            level.stacks.resize(secondary + 1);
+        }
+        level.stacks[secondary].push_back(item);
+
+        // Mantém os cursores apontando para o melhor balde possivelmente não vazio
+        if (level.count == 0 || (highSecondaryFirst ? secondary > level.cursor : secondary < level.cursor)) {
+            level.cursor = secondary;
+        }
+        level.count++;
+        if (count == 0 || primary < minPrimary) {
+            minPrimary = primary;
+        }
+        count++;
+    }
+
+    // Elemento de maior prioridade (a fila não pode estar vazia)
+    T& top() {
+        return current().back();
+    }
+
+    void pop() {
+        current().pop_back();
+        levels[minPrimary].count--;
+        count--;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Esvazia a fila mantendo os baldes já alocados, para reaproveitá-la na próxima busca
+    void clear() {
+        for (Level& level : levels) {
+            for (std::vector<T>& stack : level.stacks) {
+                stack.clear();
+            }
+            level.count = 0;
+            level.cursor = 0;
+        }
+        count = 0;
+        minPrimary = 0;
+    }
+
+private:
+    struct Level {
+        std::vector<std::vector<T>> stacks; // Um balde (pilha) por chave secundária
+        size_t count = 0; // Elementos neste nível
+        int cursor = 0; // Melhor chave secundária possivelmente não vazia
+    };
+
+    std::vector<Level> levels; // Um nível por chave principal
+    bool highSecondaryFirst;
+    size_t count; // Total de elementos
+    int minPrimary; // Menor chave principal possivelmente não vazia
+
+    // Avança os cursores até o balde de maior prioridade
+    std::vector<T>& current() {
+        while (levels[minPrimary].count == 0) {
+            minPrimary++;
+        }
+        Level& level = levels[minPrimary];
+        while (level.stacks[level.cursor].empty()) {
+            level.cursor += highSecondaryFirst ? -1 : 1;
+        }
+        return level.stacks[level.cursor];
+    }
+};
+
+#endif // BUCKETQUEUE_H
@@ -1,19 +1,16 @@
 #ifndef GBFSNODE_H
 #define GBFSNODE_H
 
-#include "node.h"
+#include <cstdint>
 
+// Entrada da lista aberta da GBFS: índice do nó no NodeStore e seus custos
 class GBFSNode {
 public:
-    Node* node;
+    uint32_t node;
     int gCost;
     int hCost;
 
-    GBFSNode(Node* _node, int _gCost, int _hCost);
-};
-
-struct GBFSComparator {
-    bool operator()(const GBFSNode& a, const GBFSNode& b) const;
+    GBFSNode(uint32_t _node, int _gCost, int _hCost);
 };
 
 #endif // GBFSNODE_H
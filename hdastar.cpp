@@ -0,0 +1,218 @@
+#include "hdastar.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+HDAStar::HDAStar(const std::vector<int>& _finalVector, int _threads)
+    : finalState(_finalVector), heuristic(finalState), threads(std::max(1, _threads)),
+      incumbent(INT_MAX), inFlight(0), idleCount(0), busyEpoch(0), done(false) {}
+
+void HDAStar::usePatternDatabase(const AdditivePDB* _pdb) {
+    heuristic.usePatternDatabase(_pdb);
+}
+
+void HDAStar::setHeuristic(HeuristicType type) {
+    heuristic.setType(type);
+}
+
+// Guarda o nó se ele melhora o custo conhecido do estado (reabrindo-o se já foi expandido)
+void HDAStar::receive(Worker& worker, const HdaMessage& message) {
+    if (message.g + message.h >= incumbent.load(std::memory_order_relaxed)) {
+        return; // Não pode levar a uma solução melhor que a atual
+    }
+    bool inserted;
+    Record& record = worker.closed.insert(message.state.key(), inserted);
+    if (!inserted) {
+        if (record.g <= message.g) {
+            worker.stats.duplicates++;
+            return; // Duplicata sem melhora
+        }
+        worker.stats.reopened++;
+    }
+    record.g = message.g;
+    record.parent = message.parent;
+    worker.open.push(message.g + message.h, message.h, {message.state, message.g, message.h});
+    worker.stats.noteOpen(worker.open.size());
+}
+
+void HDAStar::send(int from, const HdaMessage& message) {
+    int to = owner(message.state.key());
+    if (to == from) {
+        receive(workers[from], message); // Estado próprio: não passa pela fila
+        return;
+    }
+    HdaBatch*& batch = workers[from].outbox[to];
+    if (!batch) {
+        batch = new HdaBatch();
+        batch->messages.reserve(BATCH_SIZE);
+    }
+    batch->messages.push_back(message);
+    if (static_cast<int>(batch->messages.size()) >= BATCH_SIZE) {
+        flush(from, to);
+    }
+}
+
+void HDAStar::flush(int from, int to) {
+    HdaBatch*& batch = workers[from].outbox[to];
+    if (batch && !batch->messages.empty()) {
+        // Conta as mensagens antes de publicá-las, para que o término nunca as perca
+        inFlight.fetch_add(static_cast<long long>(batch->messages.size()));
+        workers[to].inbox.push(batch);
+        batch = nullptr;
+    }
+}
+
+// Todas as threads ociosas e nenhuma mensagem em trânsito. A época confirma que nenhuma
+// thread saiu do ócio entre as duas leituras (sair do ócio incrementa a época antes de
+// consumir as mensagens que a acordaram).
+bool HDAStar::terminated() {
+    long long epoch = busyEpoch.load();
+    if (idleCount.load() != threads || inFlight.load() != 0) {
+        return false;
+    }
+    return busyEpoch.load() == epoch;
+}
+
+void HDAStar::run(int t) {
+    Worker& worker = workers[t];
+    while (!done.load(std::memory_order_relaxed)) {
+        // Recebe os lotes pendentes
+        HdaBatch* batch = worker.inbox.takeAll();
+        if (batch && worker.idle) {
+            busyEpoch.fetch_add(1);
+            idleCount.fetch_sub(1);
+            worker.idle = false;
+        }
+        while (batch) {
+            HdaBatch* next = batch->next;
+            for (const HdaMessage& message : batch->messages) {
+                receive(worker, message);
+            }
+            inFlight.fetch_sub(static_cast<long long>(batch->messages.size()));
+            delete batch;
+            batch = next;
+        }
+
+        // Expande alguns nós da lista aberta própria
+        for (int i = 0; i < EXPANSIONS_PER_ROUND && !worker.open.empty(); ++i) {
+            OpenEntry entry = worker.open.top();
+            if (entry.g + entry.h >= incumbent.load(std::memory_order_relaxed)) {
+                break; // Nenhum nó desta thread pode melhorar a solução atual
+            }
+            worker.open.pop();
+            uint64_t key = entry.state.key();
+            const Record& record = *worker.closed.find(key);
+            uint64_t parentKey = record.parent; // A referência não sobrevive a inserções no mapa
+            if (entry.g > record.g) {
+                continue; // Entrada velha: o estado foi reaberto com custo menor
+            }
+            if (entry.state == finalState) {
+                int best = incumbent.load();
+                while (entry.g < best && !incumbent.compare_exchange_weak(best, entry.g)) {
+                }
+                continue;
+            }
+
+            worker.stats.expanded++;
+            worker.heuristicSum += entry.h;
+            for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) {
+                int newZero = entry.state.target(m);
+                if (newZero < 0) {
+                    continue;
+                }
+                HdaMessage child;
+                child.state = entry.state.moved(newZero);
+                child.parent = key;
+                child.g = entry.g + 1;
+                child.h = heuristic.child(entry.state, entry.h, newZero);
+                if (child.state.key() != parentKey) { // Voltar ao pai nunca melhora o custo
+                    worker.stats.generated++;
+                    send(t, child);
+                } else {
+                    worker.stats.duplicates++;
+                }
+            }
+        }
+
+        bool hasWork = !worker.open.empty() && worker.open.top().g + worker.open.top().h < incumbent.load(std::memory_order_relaxed);
+        if (!hasWork) {
+            // Sem trabalho local: envia os lotes incompletos e passa a ociosa
+            for (int to = 0; to < threads; ++to) {
+                flush(t, to);
+            }
+            if (!worker.idle) {
+                worker.idle = true;
+                idleCount.fetch_add(1);
+            }
+            if (terminated()) {
+                done.store(true);
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::vector<PuzzleState> HDAStar::solve(const std::vector<int>& initialVector) {
+    workers = std::vector<Worker>(threads);
+    for (Worker& worker : workers) {
+        worker.outbox.assign(threads, nullptr);
+    }
+    incumbent = INT_MAX;
+    inFlight = 0;
+    idleCount = 0;
+    busyEpoch = 0;
+    done = false;
+
+    PuzzleState initialState(initialVector);
+    startHeuristic = heuristic.evaluate(initialState);
+    receive(workers[owner(initialState.key())], {initialState, 0, 0, startHeuristic});
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(&HDAStar::run, this, t);
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    stats.reset();
+    heuristicSum = 0;
+    threadNodes.clear();
+    for (Worker& worker : workers) {
+        stats.expanded += worker.stats.expanded;
+        stats.generated += worker.stats.generated;
+        stats.duplicates += worker.stats.duplicates;
+        stats.reopened += worker.stats.reopened;
+        stats.peakOpen += worker.stats.peakOpen;
+        stats.peakClosed += worker.closed.size(); // O conjunto fechado só cresce
+        stats.peakBytes += worker.closed.bytesUsed() + worker.stats.peakOpen * sizeof(OpenEntry);
+        heuristicSum += worker.heuristicSum;
+        threadNodes.push_back(static_cast<long long>(worker.stats.expanded));
+    }
+    if (incumbent.load() == INT_MAX) {
+        return {};
+    }
+
+    // Refaz o caminho pelos pais guardados nas listas fechadas das donas
+    std::vector<PuzzleState> path;
+    PuzzleState state = finalState;
+    while (true) {
+        path.push_back(state);
+        const Record* record = workers[owner(state.key())].closed.find(state.key());
+        if (record->parent == 0) {
+            break;
+        }
+        PuzzleState parent = state;
+        for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) { // O pai é o vizinho com a chave guardada
+            int newZero = state.target(m);
+            if (newZero >= 0 && state.moved(newZero).key() == record->parent) {
+                parent = state.moved(newZero);
+                break;
+            }
+        }
+        state = parent;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,118 @@
+#ifndef HDASTAR_H
+#define HDASTAR_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "puzzlestate.h"
+#include "stateset.h"
+#include "bucketqueue.h"
+#include "heuristic.h"
+#include "searchstats.h"
+
+// Nó gerado, enviado à thread dona do estado
+struct HdaMessage {
+    PuzzleState state;
+    uint64_t parent; // Estado pai compactado (0 na raiz)
+    int g;
+    int h;
+};
+
+// Lote de mensagens para a mesma thread
+struct HdaBatch {
+    HdaBatch* next; // Próximo lote na caixa de entrada
+    std::vector<HdaMessage> messages;
+};
+
+// Caixa de entrada sem travas: várias threads empilham lotes e a dona retira todos de
+// uma vez (pilha de Treiber; a retirada é uma troca só, então não há problema de ABA)
+class HdaInbox {
+public:
+    HdaInbox() : head(nullptr) {}
+
+    void push(HdaBatch* batch) {
+        batch->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    HdaBatch* takeAll() {
+        if (head.load(std::memory_order_relaxed) == nullptr) {
+            return nullptr;
+        }
+        return head.exchange(nullptr, std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<HdaBatch*> head;
+};
+
+// A* distribuído por hash (HDA*): cada estado pertence a uma thread, escolhida pelo hash
+// da chave compactada, que guarda sozinha suas listas aberta e fechada. Os filhos gerados
+// são agrupados por dona e enviados em lotes. A busca termina quando nenhuma thread tem
+// nó com f menor que a melhor solução encontrada e não há mensagens em trânsito.
+class HDAStar {
+public:
+    static const int BATCH_SIZE = 64; // Mensagens por lote
+    static const int EXPANSIONS_PER_ROUND = 64; // Expansões entre verificações da caixa de entrada
+
+    SearchStats stats; // Soma das threads; os picos somam os picos de cada uma
+    double heuristicSum = 0; // Soma das heurísticas dos nós expandidos
+    int startHeuristic = 0; // Heurística do estado inicial
+    std::vector<long long> threadNodes; // Nós expandidos por thread
+
+    HDAStar(const std::vector<int>& _finalVector, int _threads);
+
+    void usePatternDatabase(const AdditivePDB* _pdb); // Troca a heurística pelo banco de padrões
+    void setHeuristic(HeuristicType type); // Troca a heurística (Manhattan ou conflito linear)
+
+    // Caminho ótimo do estado inicial ao final (vazio se não houver solução)
+    std::vector<PuzzleState> solve(const std::vector<int>& initialVector);
+
+private:
+    // Registro de um estado na lista fechada da thread dona
+    struct Record {
+        uint64_t parent; // Pai no melhor caminho conhecido
+        int g; // Melhor custo conhecido
+    };
+
+    // Entrada da lista aberta
+    struct OpenEntry {
+        PuzzleState state;
+        int g;
+        int h;
+    };
+
+    // Dados de uma thread
+    struct Worker {
+        BucketQueue<OpenEntry> open;
+        StateMap<Record> closed;
+        std::vector<HdaBatch*> outbox; // Lote em montagem para cada thread
+        HdaInbox inbox;
+        SearchStats stats; // Contadores só desta thread
+        double heuristicSum = 0;
+        bool idle = false;
+    };
+
+    PuzzleState finalState;
+    Heuristic heuristic;
+    int threads;
+    std::vector<Worker> workers;
+    std::atomic<int> incumbent; // Custo da melhor solução encontrada
+    std::atomic<long long> inFlight; // Mensagens enviadas e ainda não recebidas
+    std::atomic<int> idleCount; // Threads sem trabalho
+    std::atomic<long long> busyEpoch; // Incrementado sempre que uma thread sai do ócio
+    std::atomic<bool> done;
+
+    int owner(uint64_t key) const {
+        return static_cast<int>((mixKey(key) >> 32) % static_cast<uint64_t>(threads));
+    }
+
+    void run(int t); // Laço de uma thread
+    void receive(Worker& worker, const HdaMessage& message); // Nó que chega à dona
+    void send(int from, const HdaMessage& message); // Encaminha um filho à dona
+    void flush(int from, int to); // Envia o lote em montagem de from para to
+    bool terminated(); // Detecção de término (chamada por uma thread ociosa)
+};
+
+#endif // HDASTAR_H
@@ -0,0 +1,124 @@
+#include "heuristic.h"
+
+bool parseHeuristic(const std::string& name, HeuristicType& type) {
+    if (name == "manhattan") {
+        type = HEURISTIC_MANHATTAN;
+    } else if (name == "lc") {
+        type = HEURISTIC_LINEAR_CONFLICT;
+    } else if (name == "pdb") {
+        type = HEURISTIC_PDB;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Quantas peças precisam sair da linha para que as restantes fiquem na ordem do objetivo:
+// as que ficam formam a maior subsequência crescente das posições objetivo (line[0..count-1])
+static int removalsForOrder(const int* line, int count) {
+    int longest = 0;
+    int lengthEndingAt[4];
+    for (int i = 0; i < count; ++i) {
+        lengthEndingAt[i] = 1;
+        for (int j = 0; j < i; ++j) {
+            if (line[j] < line[i] && lengthEndingAt[j] + 1 > lengthEndingAt[i]) {
+                lengthEndingAt[i] = lengthEndingAt[j] + 1;
+            }
+        }
+        if (lengthEndingAt[i] > longest) {
+            longest = lengthEndingAt[i];
+        }
+    }
+    return count - longest;
+}
+
+Heuristic::Heuristic(const PuzzleState& goal, HeuristicType _type)
+    : type(_type), manhattan(goal), pdb(nullptr), width(goal.width) {
+    const MoveTable& board = moveTableFor(goal.width);
+    for (int tile = 0; tile < 16; ++tile) {
+        goalRow[tile] = -1;
+        goalCol[tile] = -1;
+    }
+    for (int pos = 0; pos < goal.cells; ++pos) {
+        int tile = goal.at(pos);
+        if (tile != 0) { // O espaço vazio não participa de conflitos
+            goalRow[tile] = board.row[pos];
+            goalCol[tile] = board.col[pos];
+        }
+    }
+}
+
+void Heuristic::setType(HeuristicType _type) {
+    type = (_type == HEURISTIC_PDB && !pdb) ? HEURISTIC_MANHATTAN : _type;
+}
+
+void Heuristic::usePatternDatabase(const AdditivePDB* _pdb) {
+    pdb = _pdb;
+    type = pdb ? HEURISTIC_PDB : HEURISTIC_MANHATTAN;
+}
+
+int Heuristic::evaluate(const PuzzleState& state) const {
+    switch (type) {
+    case HEURISTIC_PDB:
+        return pdb->evaluate(state);
+    case HEURISTIC_LINEAR_CONFLICT: {
+        int height = state.cells / width;
+        int removals = 0;
+        for (int row = 0; row < height; ++row) {
+            removals += rowConflicts(state, row);
+        }
+        for (int col = 0; col < width; ++col) {
+            removals += colConflicts(state, col);
+        }
+        return manhattan.evaluate(state) + 2 * removals;
+    }
+    default:
+        return manhattan.evaluate(state);
+    }
+}
+
+// Um movimento vertical troca a peça de linha (mudam os conflitos das duas linhas) e um
+// horizontal troca de coluna (mudam os das duas colunas); a ordem relativa das demais
+// peças não muda, então o resto dos conflitos do pai continua valendo.
+int Heuristic::linearConflictChild(const PuzzleState& parent, int parentH, int newZero) const {
+    PuzzleState child = parent.moved(newZero);
+    int before;
+    int after;
+    if (parent.zero % width == newZero % width) {
+        int fromRow = newZero / width;
+        int toRow = parent.zero / width;
+        before = rowConflicts(parent, fromRow) + rowConflicts(parent, toRow);
+        after = rowConflicts(child, fromRow) + rowConflicts(child, toRow);
+    } else {
+        int fromCol = newZero % width;
+        int toCol = parent.zero % width;
+        before = colConflicts(parent, fromCol) + colConflicts(parent, toCol);
+        after = colConflicts(child, fromCol) + colConflicts(child, toCol);
+    }
+    return parentH + manhattan.delta(parent, newZero) + 2 * (after - before);
+}
+
+int Heuristic::rowConflicts(const PuzzleState& state, int row) const {
+    int line[4];
+    int count = 0;
+    for (int col = 0; col < width; ++col) {
+        int tile = state.at(row * width + col);
+        if (tile != 0 && goalRow[tile] == row) {
+            line[count++] = goalCol[tile];
+        }
+    }
+    return count > 1 ? removalsForOrder(line, count) : 0;
+}
+
+int Heuristic::colConflicts(const PuzzleState& state, int col) const {
+    int height = state.cells / width;
+    int line[4];
+    int count = 0;
+    for (int row = 0; row < height; ++row) {
+        int tile = state.at(row * width + col);
+        if (tile != 0 && goalCol[tile] == col) {
+            line[count++] = goalRow[tile];
+        }
+    }
+    return count > 1 ? removalsForOrder(line, count) : 0;
+}
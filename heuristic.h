@@ -0,0 +1,60 @@
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include <string>
+#include "puzzlestate.h"
+#include "manhattan.h"
+#include "pdb.h"
+
+// Heurísticas disponíveis para as buscas informadas
+enum HeuristicType {
+    HEURISTIC_MANHATTAN, // Distância de Manhattan
+    HEURISTIC_LINEAR_CONFLICT, // Manhattan + 2 por peça a retirar de cada linha/coluna em conflito
+    HEURISTIC_PDB // Banco de padrões aditivo (ver pdb.h)
+};
+
+// Converte o nome usado na linha de comando ("manhattan", "lc", "pdb"); retorna false se desconhecido
+bool parseHeuristic(const std::string& name, HeuristicType& type);
+
+// Heurística escolhida para um estado objetivo. Além da avaliação completa (usada na
+// raiz), calcula a heurística do filho a partir da do pai: Manhattan muda só na peça
+// movida e o conflito linear só nas duas linhas (ou colunas) atravessadas por ela.
+class Heuristic {
+public:
+    explicit Heuristic(const PuzzleState& goal, HeuristicType _type = HEURISTIC_MANHATTAN);
+
+    void setType(HeuristicType _type); // HEURISTIC_PDB só vale depois de usePatternDatabase
+    HeuristicType getType() const { return type; }
+
+    // Passa a usar o banco de padrões (ou volta para Manhattan se pdb for nulo)
+    void usePatternDatabase(const AdditivePDB* _pdb);
+
+    // Avaliação completa do estado
+    int evaluate(const PuzzleState& state) const;
+
+    // Heurística do filho obtido movendo o zero de parent para newZero
+    int child(const PuzzleState& parent, int parentH, int newZero) const {
+        switch (type) {
+        case HEURISTIC_PDB:
+            return pdb->evaluate(parent.moved(newZero));
+        case HEURISTIC_LINEAR_CONFLICT:
+            return linearConflictChild(parent, parentH, newZero);
+        default:
+            return parentH + manhattan.delta(parent, newZero);
+        }
+    }
+
+private:
+    HeuristicType type;
+    ManhattanTable manhattan;
+    const AdditivePDB* pdb; // Banco de padrões, quando type == HEURISTIC_PDB
+    int width; // Largura do tabuleiro
+    int goalRow[16]; // Linha objetivo de cada peça
+    int goalCol[16]; // Coluna objetivo de cada peça
+
+    int linearConflictChild(const PuzzleState& parent, int parentH, int newZero) const;
+    int rowConflicts(const PuzzleState& state, int row) const; // Peças a retirar da linha
+    int colConflicts(const PuzzleState& state, int col) const; // Peças a retirar da coluna
+};
+
+#endif // HEURISTIC_H
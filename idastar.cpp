@@ -1,191 +1,355 @@
 #include "idastar.h"
 #include <iostream>
 #include <algorithm>
-#include <unordered_set>
 #include <cmath>
+#include <climits>
 #include <chrono>
 #include <vector>
+#include <thread>
 
 // Implementação do construtor da classe Node
-IdaStarNode::IdaStarNode(const std::vector<int>& _state, IdaStarNode* _parent)
+IdaStarNode::IdaStarNode(const PuzzleState& _state, IdaStarNode* _parent)
     : state(_state), parent(_parent), g_cost(0), h_cost(0), f_cost(0) {}
 
 // Localiza a posição do zero no estado
 int IdaStarNode::findZero() const {
-    for (int i = 0; i < state.size(); ++i) {
-        if (state[i] == 0) {
-            return i;
-        }
-    }
-    return -1; // Se não encontrar o zero
+    return state.findZero();
 }
 
-// Métodos para movimentação do zero
-IdaStarNode* IdaStarNode::moveUp() {
-    int zero_pos = findZero();
-    if (zero_pos >= 3) { // Pode mover para cima
-        std::vector<int> new_state = state;
-        std::swap(new_state[zero_pos], new_state[zero_pos - 3]);
-        return new IdaStarNode(new_state, this);
-    }
-    return nullptr;
+// Função para calcular a distância Manhattan
+int manhattanDistance(const PuzzleState& state, const PuzzleState& goal) {
+    return ManhattanTable(goal).evaluate(state);
 }
 
-IdaStarNode* IdaStarNode::moveLeft() {
-    int zero_pos = findZero();
-    if (zero_pos % 3 > 0) { // Pode mover para a esquerda
-        std::vector<int> new_state = state;
-        std::swap(new_state[zero_pos], new_state[zero_pos - 1]);
-        return new IdaStarNode(new_state, this);
-    }
-    return nullptr;
-}
+// Implementação do construtor da classe IDAStar
+IDAStar::IDAStar(const std::vector<int>& _goal_state)
+    : goal_state(_goal_state), heuristic(goal_state), start_heuristic(0),
+      heuristic_sum(0), threads(1), table_bytes(0), limit(0), searches(1), stop(false), solution_thread(0), pruning(nullptr) {}
 
-IdaStarNode* IdaStarNode::moveRight() {
-    int zero_pos = findZero();
-    if (zero_pos % 3 < 2) { // Pode mover para a direita
-        std::vector<int> new_state = state;
-        std::swap(new_state[zero_pos], new_state[zero_pos + 1]);
-        return new IdaStarNode(new_state, this);
-    }
-    return nullptr;
+void IDAStar::usePatternDatabase(const AdditivePDB* _pdb) {
+    heuristic.usePatternDatabase(_pdb);
 }
 
-IdaStarNode* IdaStarNode::moveDown() {
-    int zero_pos = findZero();
-    if (zero_pos < 6) { // Pode mover para baixo
-        std::vector<int> new_state = state;
-        std::swap(new_state[zero_pos], new_state[zero_pos + 3]);
-        return new IdaStarNode(new_state, this);
-    }
-    return nullptr;
+void IDAStar::setHeuristic(HeuristicType type) {
+    heuristic.setType(type);
 }
 
-// Função para calcular a distância Manhattan
-int manhattanDistance(const std::vector<int>& state, const std::vector<int>& goal) {
-    int distance = 0;
-    for (int i = 0; i < state.size(); ++i) {
-        if (state[i] != 0) {
-            int goal_pos = std::find(goal.begin(), goal.end(), state[i]) - goal.begin();
-            int row_distance = std::abs(i / 3 - goal_pos / 3);
-            int col_distance = std::abs(i % 3 - goal_pos % 3);
-            distance += row_distance + col_distance;
-        }
+void IDAStar::useTranspositionTable(size_t bytes) {
+    table_bytes = bytes;
+    for (Search& search : searches) {
+        search.table.resize(table_bytes / searches.size()); // No modo paralelo, cada thread fica com uma parte
     }
-    return distance;
 }
 
-// Implementação do construtor da classe IDAStar
-IDAStar::IDAStar(const std::vector<int>& _goal_state)
-    : goal_state(_goal_state), nodes_expanded(0), nodes_generated(0), heuristic_sum(0), start_heuristic(0) {}
+void IDAStar::useThreads(int _threads) {
+    threads = std::max(1, _threads);
+    searches = std::vector<Search>(threads);
+    useTranspositionTable(table_bytes);
+}
 
-// Função para rastrear o caminho do nó final ao início
-std::vector<IdaStarNode*> IDAStar::tracePath(IdaStarNode* node) {
+// Reconstrói o caminho da solução reaplicando a pilha de movimentos ao estado inicial
+std::vector<IdaStarNode*> IDAStar::tracePath(const PuzzleState& initial_state, const uint8_t* moves, int length) {
+    solution_nodes.clear();
+    solution_nodes.reserve(length + 1); // Os ponteiros para os pais continuam válidos
+    PuzzleState state = initial_state;
+    IdaStarNode* parent = nullptr;
+    for (int g = 0; g <= length; ++g) {
+        if (g > 0) {
+            state = state.moved(state.target(moves[g - 1]));
+        }
+        solution_nodes.emplace_back(state, parent);
+        IdaStarNode& node = solution_nodes.back();
+        node.g_cost = g;
+        node.h_cost = heuristic.evaluate(state);
+        node.f_cost = node.g_cost + node.h_cost;
+        parent = &node;
+    }
     std::vector<IdaStarNode*> path;
-    while (node) {
-        path.push_back(node);
-        node = node->parent;
-         
+    for (IdaStarNode& node : solution_nodes) {
+        path.push_back(&node);
     }
-    std::reverse(path.begin(), path.end()); // Inverte para obter a ordem correta
     return path;
 }
 
-// Função recursiva para busca de profundidade limitada
-std::pair<int, std::vector<IdaStarNode*>> IDAStar::depthLimitedSearch(
-    IdaStarNode* node,
-    int g_cost,
-    int limit,
-    std::unordered_set<std::vector<int>, VectorHash>& visited) {
-   	nodes_expanded++;
-    heuristic_sum += node->h_cost;
-    nodes_generated++;
-    int h_cost = manhattanDistance(node->state, goal_state);
+// Busca em profundidade limitada sobre o tabuleiro único: aplica o movimento, desce e
+// desfaz o movimento, sem alocar nada por nó. Retorna FOUND ou um limite inferior do
+// custo f de qualquer solução que passe pelo nó (usado para melhorar h na tabela).
+template <typename Domain>
+int IDAStar::depthLimitedSearch(Search& search, int g_cost, int h_cost, int fsm_state) {
+    if (stop.load(std::memory_order_relaxed)) {
+        return INT_MAX; // Outra thread já achou a solução
+    }
+    search.deepest = std::max(search.deepest, g_cost);
+
+    PuzzleState& board = search.board;
+    TranspositionTable& table = search.table;
     int f_cost = g_cost + h_cost;
+    uint64_t key = board.key();
+    if (f_cost <= limit && table.enabled()) {
+        TranspositionTable::Entry* entry = table.find(key);
+        if (entry) {
+            // O estado já foi alcançado com g menor, ou com o mesmo g e a subárvore já
+            // foi esgotada nesta iteração: a subárvore daqui não traz nada de novo
+            if (table.currentSearch(*entry) && (entry->g < g_cost || (entry->g == g_cost && table.searchedThisIteration(*entry)))) {
+                table.cutoffs++;
+                search.nodes_pruned++;
+                return g_cost + entry->h;
+            }
+            f_cost = g_cost + std::max<int>(h_cost, entry->h); // h melhorado em iterações anteriores
+        }
+    }
 
-    node->g_cost = g_cost;
-    node->h_cost = h_cost;
-    node->f_cost = f_cost;
+    // Os nós cortados pela tabela ficam só em cutoffs; os demais contam como expandidos
+    search.nodes_expanded++;
+    search.heuristic_sum += h_cost;
 
     if (f_cost > limit) {
-        return {f_cost, {}};  // Se f_cost ultrapassar o limite, retorna o próximo limite
+        search.next_limit = std::min(search.next_limit, f_cost); // Candidato ao próximo limite
+        return f_cost;
+    }
+
+    if (board == goal_state) {
+        search.solution_length = g_cost;
+        return FOUND; // Encontrou uma solução; o caminho está na pilha de movimentos
     }
 
-    if (node->state == goal_state) {
-        return {INT_MAX, tracePath(node)};  // Se encontrou uma solução
+    if (g_cost >= MAX_DEPTH) {
+        return f_cost;
     }
 
-    // Gerar filhos na ordem especificada
-    std::vector<IdaStarNode*> children = {
-        node->moveUp(),
-        node->moveLeft(),
-        node->moveRight(),
-        node->moveDown(),
-    };
+    if (table.enabled()) {
+        table.store(key, g_cost, f_cost - g_cost); // Marca o estado no caminho atual
+    }
 
-    // Remover filhos nulos
-    children.erase(
-        std::remove_if(children.begin(), children.end(), [](IdaStarNode* child) { return child == nullptr; }), 
-        children.end());
+    // Gerar filhos na ordem: cima, esquerda, direita, baixo
+    int bound = INT_MAX;
+    int old_zero = board.zero;
+    for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) {
+        int new_zero = Domain::moves.target[board.zero][m];
+        if (new_zero < 0) {
+            continue;
+        }
+        int child_fsm = pruning->next(fsm_state, m);
+        if (child_fsm == MovePruning::PRUNED) {
+            search.nodes_pruned++;
+            if (table.enabled()) {
+                // O filho podado não é visitado, mas o h propagado para a tabela precisa
+                // continuar um limite inferior quando o estado for alcançado por outro
+                // caminho: o f estático do filho entra no limite
+                bound = std::min(bound, g_cost + 1 + heuristic.child(board, h_cost, new_zero));
+            }
+            continue; // Desfaz o último movimento ou repete uma transposição já coberta
+        }
+        search.nodes_generated++;
+        int child_h = heuristic.child(board, h_cost, new_zero); // Heurística do filho, a partir da do pai
+
+        search.moves[g_cost] = static_cast<uint8_t>(m);
+        board = board.moved(new_zero); // Aplica o movimento
+        int result = depthLimitedSearch<Domain>(search, g_cost + 1, child_h, child_fsm);
+        if (result == FOUND) {
+            return FOUND;
+        }
+        bound = std::min(bound, result);
+        board = board.moved(old_zero); // Desfaz o movimento
+    }
 
-    int next_limit = INT_MAX;
+    if (table.enabled() && !stop.load(std::memory_order_relaxed)) { // Se parou no meio, a subárvore não foi esgotada
+        table.update(key, g_cost, bound - g_cost); // Subárvore esgotada: guarda o h propagado
+    }
+    return bound;
+}
 
-    for (IdaStarNode* child : children) {
-        if (visited.find(child->state) != visited.end()) {
-            nodes_expanded--;
+// Gera o próximo nível da fronteira a partir do atual, na mesma ordem da busca serial.
+// A divisão não conta nós expandidos: cada subárvore é contada pela thread que a
+// resolve. Os filhos acima do limite só entram como candidatos ao próximo limite.
+template <typename Domain>
+bool IDAStar::expandFrontier(Search& search) {
+    next_frontier.clear();
+    for (const FrontierNode& node : frontier) {
+        if (node.state == goal_state) {
+            return false; // A busca serial acha o objetivo e conta os nós até ele
+        }
+        for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) {
+            int new_zero = Domain::moves.target[node.state.zero][m];
+            if (new_zero < 0) {
+                continue;
+            }
+            int child_fsm = pruning->next(node.fsm_state, m);
+            if (child_fsm == MovePruning::PRUNED) {
+                continue;
+            }
+            int child_h = heuristic.child(node.state, node.h_cost, new_zero);
+            int child_f = node.g_cost + 1 + child_h;
+            if (child_f > limit) {
+                search.next_limit = std::min(search.next_limit, child_f);
+                continue;
+            }
+            FrontierNode child;
+            child.state = node.state.moved(new_zero);
+            child.g_cost = node.g_cost + 1;
+            child.h_cost = child_h;
+            child.fsm_state = child_fsm;
+            std::copy(node.moves, node.moves + node.g_cost, child.moves);
+            child.moves[node.g_cost] = static_cast<uint8_t>(m);
+            next_frontier.push_back(child);
         }
+    }
+    frontier.swap(next_frontier);
+    return !frontier.empty();
+}
 
-        visited.insert(child->state);
+template <typename Domain>
+bool IDAStar::iteration(const PuzzleState& initial_state) {
+    return (threads > 1) ? parallelIteration<Domain>(initial_state) : serialIteration<Domain>(initial_state);
+}
 
-        auto result = depthLimitedSearch(child, g_cost + 1, limit, visited);
+template <typename Domain>
+bool IDAStar::serialIteration(const PuzzleState& initial_state) {
+    Search& search = searches[0];
+    search.board = initial_state;
+    search.nodes_generated++; // A raiz de cada iteração
+    return depthLimitedSearch<Domain>(search, 0, start_heuristic, MovePruning::START) == FOUND;
+}
 
-        if (!result.second.empty()) {  // Se uma solução foi encontrada
-            return result;
+// Uma iteração em paralelo: a fronteira cresce um nível por vez a partir da raiz até ter
+// FRONTIER_TARGET subárvores, que as threads pegam dinamicamente por um cursor atômico.
+// Se a árvore da iteração é pequena demais para isso, a iteração é feita em série. O
+// menor f acima do limite é combinado atomicamente e a primeira thread que acha o
+// objetivo para as demais.
+template <typename Domain>
+bool IDAStar::parallelIteration(const PuzzleState& initial_state) {
+    Search& root = searches[0];
+    const int max_depth = static_cast<int>(sizeof(FrontierNode().moves));
+    frontier.clear();
+    FrontierNode start;
+    start.state = initial_state;
+    start.g_cost = 0;
+    start.h_cost = start_heuristic;
+    start.fsm_state = MovePruning::START;
+    frontier.push_back(start);
+    while (frontier.size() < FRONTIER_TARGET) {
+        if (frontier[0].g_cost >= max_depth || !expandFrontier<Domain>(root)) {
+            return serialIteration<Domain>(initial_state);
         }
-        next_limit = std::min(next_limit, result.first);
+    }
 
-        delete child;  // Limpeza para evitar vazamentos de memória
+    std::atomic<size_t> cursor(0);
+    std::atomic<int> shared_limit(root.next_limit);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            Search& search = searches[t];
+            auto start_time = std::chrono::steady_clock::now();
+            while (!stop.load(std::memory_order_relaxed)) {
+                size_t next = cursor.fetch_add(1);
+                if (next >= frontier.size()) {
+                    break;
+                }
+                const FrontierNode& node = frontier[next];
+                search.board = node.state;
+                std::copy(node.moves, node.moves + node.g_cost, search.moves);
+                search.next_limit = INT_MAX;
+                if (depthLimitedSearch<Domain>(search, node.g_cost, node.h_cost, node.fsm_state) == FOUND) {
+                    bool expected = false;
+                    if (stop.compare_exchange_strong(expected, true)) {
+                        solution_thread = t;
+                    }
+                    break;
+                }
+                // Compartilha o menor f acima do limite visto nesta subárvore
+                int current = shared_limit.load(std::memory_order_relaxed);
+                while (search.next_limit < current && !shared_limit.compare_exchange_weak(current, search.next_limit)) {
+                }
+            }
+            auto end_time = std::chrono::steady_clock::now();
+            thread_stats[t].busySeconds += std::chrono::duration<double>(end_time - start_time).count();
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
     }
+    root.next_limit = shared_limit.load();
+    return stop.load();
+}
 
-    return {next_limit, {}};  // Retorna o próximo limite
+// Os contadores dos contextos só crescem durante a busca; stats guarda a soma deles e a
+// memória das tabelas, da fronteira e das pilhas de movimentos
+void IDAStar::collectStats() {
+    stats.expanded = stats.generated = stats.duplicates = 0;
+    size_t bytes = (frontier.capacity() + next_frontier.capacity()) * sizeof(FrontierNode);
+    for (const Search& search : searches) {
+        stats.expanded += search.nodes_expanded;
+        stats.generated += search.nodes_generated;
+        stats.duplicates += search.nodes_pruned;
+        stats.noteOpen(search.deepest);
+        bytes += sizeof(Search) + search.table.bytes();
+    }
+    stats.noteBytes(bytes);
 }
 
 // Implementação do método para busca IDA*
-std::vector<IdaStarNode*> IDAStar::idaStar(const std::vector<int>& initial_state) {
-    start_heuristic = manhattanDistance(initial_state, goal_state);
-
-    IdaStarNode* initial_node = new IdaStarNode(initial_state);
-    initial_node->h_cost = start_heuristic;
-
-    int limit = start_heuristic;
-    std::vector<IdaStarNode*> solution_path;
-    std::unordered_set<std::vector<int>, VectorHash> visited;
-
-    while (solution_path.empty()) { 
-        visited.insert(initial_node->state);
+std::vector<IdaStarNode*> IDAStar::idaStar(const std::vector<int>& initial_vector) {
+    PuzzleState initial_state(initial_vector);
+    start_heuristic = heuristic.evaluate(initial_state);
+
+    // A poda vale também com a tabela de transposição: as duas preferem o caminho que vem
+    // antes na ordem dos movimentos, e depthLimitedSearch conta os filhos podados no h
+    // propagado para que a tabela continue admissível
+    pruning = &MovePruning::transpositions();
+
+    limit = start_heuristic;
+    stop = false;
+    solution_thread = 0;
+    thread_stats.assign(threads, IdaThreadStats{0, 0.0});
+    stats.reset(); // O objeto pode ser reaproveitado entre instâncias
+    heuristic_sum = 0;
+    for (Search& search : searches) {
+        search.nodes_expanded = 0;
+        search.nodes_generated = 0;
+        search.nodes_pruned = 0;
+        search.deepest = 0;
+        search.heuristic_sum = 0;
+        search.table.newSearch();
+    }
 
-        auto result = depthLimitedSearch(initial_node, 0, limit, visited);
-        
-        if (!result.second.empty()) {
-            solution_path = result.second;  // Solução encontrada
-        } else {
-            limit = result.first;  // Atualiza o limite para próxima iteração
+    bool found = false;
+    while (true) {
+        searches[0].next_limit = INT_MAX;
+        stats.beginIteration(limit);
+        // Cada tamanho de tabuleiro tem sua instância dos laços da busca
+        found = (goal_state.width == Domain15::width) ? iteration<Domain15>(initial_state) : iteration<Domain8>(initial_state);
+        collectStats();
+        stats.endIteration();
+        if (found || searches[0].next_limit == INT_MAX) {
+            break; // Achou a solução, ou nenhum nó ultrapassou o limite: não há solução
+        }
+        limit = searches[0].next_limit; // Atualiza o limite para próxima iteração
+        for (Search& search : searches) {
+            search.table.newIteration();
         }
     }
 
-    return solution_path;  // Retorna o caminho para a solução
+    for (int t = 0; t < threads; ++t) {
+        heuristic_sum += searches[t].heuristic_sum;
+        thread_stats[t].nodes = searches[t].nodes_expanded;
+    }
+    if (!found) {
+        return {};
+    }
+    const Search& winner = searches[solution_thread];
+    return tracePath(initial_state, winner.moves, winner.solution_length);
 }
 
 // Métodos para obter informações do IDAStar
-int IDAStar::getNodesExpanded() const {
-    return nodes_expanded;
+long long IDAStar::getNodesExpanded() const {
+    return static_cast<long long>(stats.expanded);
 }
 
-int IDAStar::getNodesGenerated() const {
-    return nodes_generated;
+long long IDAStar::getNodesGenerated() const {
+    return static_cast<long long>(stats.generated);
 }
 
-int IDAStar::getHeuristicSum() const {
+double IDAStar::getHeuristicSum() const {
     return heuristic_sum;
 }
 
@@ -3,68 +3,136 @@
 
 #include <iostream>
 #include <vector>
-#include <unordered_set>
+#include <cstdint>
+#include <atomic>
 #include <algorithm>
 #include <cmath>
+#include "puzzlestate.h"
+#include "manhattan.h"
+#include "heuristic.h"
+#include "transposition.h"
+#include "movepruning.h"
+#include "searchstats.h"
 
 using namespace std;
 
-// Estrutura para hash de vetores de inteiros
-struct VectorHash {
-    size_t operator()(const vector<int>& v) const {
-        size_t hash = 0;
-        for (int i : v) {
-            hash ^= std::hash<int>{}(i) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-        }
-        return hash;
-    }
-};
-
-// Declaração da classe Node para representar os estados do quebra-cabeça
+// Nó do caminho da solução (a busca em si não cria nós: ela altera um único tabuleiro)
 class IdaStarNode {
 public:
-    vector<int> state;
+    PuzzleState state;
     IdaStarNode* parent;
     int g_cost;
     int h_cost;
     int f_cost;
 
-    IdaStarNode(const vector<int>& _state, IdaStarNode* _parent = nullptr);
+    IdaStarNode(const PuzzleState& _state, IdaStarNode* _parent = nullptr);
 
     int findZero() const; // Localiza a posição do zero no estado
-    IdaStarNode* moveUp(); // Move para cima, se possível
-    IdaStarNode* moveLeft(); // Move para a esquerda, se possível
-    IdaStarNode* moveRight(); // Move para a direita, se possível
-    IdaStarNode* moveDown(); // Move para baixo, se possível
 };
 
 // Função para calcular a distância Manhattan
-int manhattanDistance(const vector<int>& state, const vector<int>& goal);
+int manhattanDistance(const PuzzleState& state, const PuzzleState& goal);
+
+// Estatísticas de uma thread do IDA* paralelo
+struct IdaThreadStats {
+    long long nodes; // Nós expandidos pela thread
+    double busySeconds; // Tempo gasto resolvendo subárvores
+    double nodesPerSecond() const { return busySeconds > 0 ? nodes / busySeconds : 0.0; }
+};
 
 // Declaração da classe IDAStar
 class IDAStar {
 public:
-    vector<int> goal_state; // Estado objetivo do quebra-cabeça
-    int nodes_expanded; // Número de nós expandidos
-    int nodes_generated; // Número de nós gerados
-    int heuristic_sum; // Soma das heurísticas
+    static const int MAX_DEPTH = 256; // Profundidade máxima da pilha de movimentos
+    static const int FOUND = -1; // Retorno de depthLimitedSearch quando acha o objetivo
+    static const int FRONTIER_TARGET = 2048; // Subárvores por iteração no modo paralelo
+
+    PuzzleState goal_state; // Estado objetivo do quebra-cabeça
+    Heuristic heuristic; // Heurística escolhida (Manhattan por padrão) para o estado objetivo
     int start_heuristic; // Heurística do estado inicial
 
     IDAStar(const vector<int>& _goal_state);
 
-    // Função para rastrear o caminho do nó final ao início
-    vector<IdaStarNode*> tracePath(IdaStarNode* node);
-
-    // Função recursiva para busca de profundidade limitada
-    pair<int, vector<IdaStarNode*>> depthLimitedSearch(IdaStarNode* node, int g_cost, int limit, unordered_set<vector<int>, VectorHash>& visited);
+    void usePatternDatabase(const AdditivePDB* _pdb); // Troca a heurística pelo banco de padrões
+    void setHeuristic(HeuristicType type); // Troca a heurística (Manhattan ou conflito linear)
+    void useTranspositionTable(size_t bytes); // Liga a tabela de transposição com até bytes de memória (0 desliga)
+    void useThreads(int _threads); // Número de threads por busca (1 = busca serial)
 
     // Função para iniciar a busca IDA*
     vector<IdaStarNode*> idaStar(const vector<int>& initial_state);
 
-    int getNodesExpanded() const; // Retorna o número de nós expandidos
-    int getNodesGenerated() const; // Retorna o número de nós gerados
-    int getHeuristicSum() const; // Retorna a soma das heurísticas
+    long long getNodesExpanded() const; // Retorna o número de nós expandidos
+    long long getNodesGenerated() const; // Retorna o número de nós gerados
+    double getHeuristicSum() const; // Retorna a soma das heurísticas
+    const SearchStats& getStats() const { return stats; } // Contadores da última busca, com os de cada iteração
     int getStartHeuristic() const; // Retorna a heurística do estado inicial
+    const TranspositionTable& getTranspositionTable() const { return searches[0].table; } // Estatísticas da tabela (da thread 0)
+    const vector<IdaThreadStats>& getThreadStats() const { return thread_stats; } // Nós e tempo por thread da última busca
+
+private:
+    // Estado de uma busca em profundidade; no modo paralelo cada thread tem o seu
+    struct Search {
+        PuzzleState board; // Tabuleiro único: cada movimento é aplicado e desfeito no lugar
+        uint8_t moves[MAX_DEPTH]; // Pilha de movimentos do caminho atual (ver Move)
+        int next_limit; // Menor f que ultrapassou o limite (limite da próxima iteração)
+        int solution_length; // Profundidade em que o objetivo foi encontrado
+        long long nodes_expanded;
+        long long nodes_generated;
+        long long nodes_pruned; // Filhos podados pelo autômato e cortes por transposição
+        int deepest; // Maior g alcançado
+        double heuristic_sum;
+        TranspositionTable table; // Tabela de transposição (desligada por padrão)
+    };
+
+    // Subárvore da fronteira distribuída entre as threads
+    struct FrontierNode {
+        PuzzleState state;
+        int g_cost;
+        int h_cost;
+        int fsm_state; // Estado do autômato de poda depois dos movimentos abaixo
+        uint8_t moves[32]; // Movimentos desde a raiz
+    };
+
+    SearchStats stats; // Soma dos contextos, atualizada ao fim de cada iteração
+    double heuristic_sum; // Soma das heurísticas
+    int threads; // Threads por busca
+    size_t table_bytes; // Memória total das tabelas de transposição
+    int limit; // Limite de f da iteração atual
+    vector<Search> searches; // Um contexto por thread (o primeiro também é o da busca serial)
+    vector<FrontierNode> frontier; // Subárvores da iteração atual (modo paralelo)
+    vector<FrontierNode> next_frontier; // Nível seguinte, montado por expandFrontier
+    vector<IdaThreadStats> thread_stats;
+    std::atomic<bool> stop; // Alguma thread achou a solução: as demais param
+    int solution_thread; // Contexto que contém o caminho da solução
+    vector<IdaStarNode> solution_nodes; // Caminho da última solução
+    const MovePruning* pruning; // Poda de movimentos da busca atual
+
+    // Os laços da busca são instanciados por domínio (PuzzleDomain), para que a tabela de
+    // movimentos seja constante no laço mais quente.
+
+    // Busca em profundidade limitada a partir de search.board, com custo g, heurística h e
+    // o estado do autômato de poda; retorna FOUND se chegou ao objetivo (o caminho fica
+    // em search.moves[0..g-1])
+    template <typename Domain>
+    int depthLimitedSearch(Search& search, int g_cost, int h_cost, int fsm_state);
+
+    // Troca frontier pelo próximo nível (os filhos com f <= limit); retorna false se a
+    // fronteira não pode mais ser dividida (o nível seguinte é vazio ou o objetivo está
+    // no nível atual)
+    template <typename Domain>
+    bool expandFrontier(Search& search);
+
+    void collectStats(); // Soma os contadores dos contextos em stats
+
+    template <typename Domain>
+    bool iteration(const PuzzleState& initial_state); // Uma iteração, serial ou paralela
+    template <typename Domain>
+    bool serialIteration(const PuzzleState& initial_state); // Uma iteração com uma thread
+    template <typename Domain>
+    bool parallelIteration(const PuzzleState& initial_state); // Uma iteração com threads threads
+
+    // Reconstrói o caminho da solução a partir do estado inicial e da pilha de movimentos
+    vector<IdaStarNode*> tracePath(const PuzzleState& initial_state, const uint8_t* moves, int length);
 };
 
 #endif // IDASTAR_H
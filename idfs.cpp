@@ -1,70 +1,21 @@
 #include "idfs.h"
 #include <iostream>
 #include <algorithm>
-#include <queue>
 #include <chrono>
 #include <vector>
 
 // Construtor da classe Node
-IDFSNode::IDFSNode(const std::vector<int>& _initialVector, IDFSNode* _parent)
-    : initialVector(_initialVector), parent(_parent) {}
+IDFSNode::IDFSNode(const PuzzleState& _state, IDFSNode* _parent)
+    : state(_state), parent(_parent) {}
 
 // Método para encontrar a posição do zero
 int IDFSNode::findZero() const {
-    auto it = std::find(initialVector.begin(), initialVector.end(), 0);
-    return static_cast<int>(std::distance(initialVector.begin(), it));
-}
-
-// Métodos para mover o zero no quebra-cabeça
-void IDFSNode::moveUp() {
-    int zPos = findZero();
-    if (zPos >= 3) { // Pode mover para cima
-        std::vector<int> temp = initialVector;
-        std::swap(temp[zPos], temp[zPos - 3]);
-        IDFSNode* child = new IDFSNode(temp, this);
-        children.push_back(child);
-    }
-}
-
-void IDFSNode::moveDown() {
-    int zPos = findZero();
-    if (zPos < 6) { // Pode mover para baixo
-        std::vector<int> temp = initialVector;
-        std::swap(temp[zPos], temp[zPos + 3]);
-        IDFSNode* child = new IDFSNode(temp, this);
-        children.push_back(child);
-    }
-}
-
-void IDFSNode::moveRight() {
-    int zPos = findZero();
-    if (zPos % 3 < 2) { // Pode mover para a direita
-        std::vector<int> temp = initialVector;
-        std::swap(temp[zPos], temp[zPos + 1]);
-        IDFSNode* child = new IDFSNode(temp, this);
-        children.push_back(child);
-    }
-}
-
-void IDFSNode::moveLeft() {
-    int zPos = findZero();
-    if (zPos % 3 > 0) { // Pode mover para a esquerda
-        std::vector<int> temp = initialVector;
-        std::swap(temp[zPos], temp[zPos - 1]);
-        IDFSNode* child = new IDFSNode(temp, this);
-        children.push_back(child);
-    }
+    return state.findZero();
 }
 
 // Método para imprimir o estado do quebra-cabeça
 void IDFSNode::printPuzzle() const {
-    int count = 0;
-    for (auto i : initialVector) {
-        if (count % 3 == 0)
-            std::cout << "\n";
-        std::cout << i << ' ';
-        count++;
-    }
+    state.printPuzzle();
 }
 
 // Função para rastrear a solução
@@ -88,22 +39,22 @@ int traceSolution(std::vector<IDFSNode*>& solution, IDFSNode* goal) {
 }
 
 // Construtor da classe Puzzle
-IDFSPuzzle::IDFSPuzzle(const std::vector<int>& _initialVector, const std::vector<int>& _finalVector)
-    : finalVector(_finalVector), nodesCount(0), depth(0) {
-    IDFSNode* initialNode = new IDFSNode(_initialVector, nullptr);
-    queue.push(initialNode);
-    visited[_initialVector] = true;
-}
+IDFSPuzzle::IDFSPuzzle(const std::vector<int>& _finalVector)
+    : finalState(_finalVector), depth(0) {}
 
 // Implementação do IDFS
 int IDFSPuzzle::IDFS(const std::vector<int>& initialVector) {
     int objective = -1;
     depth = 0;
+    stats.reset();
+    path.clear();
 
-    IDFSNode* initialNode = new IDFSNode(initialVector, nullptr);
+    IDFSNode initialNode(PuzzleState(initialVector), nullptr);
 
     while (true) {
-        objective = recursive_idfs(depth, initialNode);
+        stats.beginIteration(depth);
+        objective = recursive_idfs(depth, &initialNode);
+        stats.endIteration();
 
         if (objective != -1) {
             break;
@@ -112,71 +63,51 @@ int IDFSPuzzle::IDFS(const std::vector<int>& initialVector) {
         depth++; // Aumenta a profundidade permitida
     }
 
-    delete initialNode; // Limpa a memória do nó inicial
-    
+    stats.noteBytes(stats.peakOpen * sizeof(IDFSNode)); // Só o caminho atual fica na pilha
     return objective; // Retorna a profundidade onde encontrou a solução
 }
 
 // Implementação do método recursivo para IDFS
-int IDFSPuzzle::recursive_idfs(int maxDepth, IDFSNode* currentState) {
+int IDFSPuzzle::recursive_idfs(int maxDepth, IDFSNode* currentState, int fsmState) {
 	
 	int objective = 0;
     std::vector<IDFSNode *> solution;
 
 		// Verificando se o estado atual é Goal
-    if (currentState->initialVector == this->finalVector) {
+    if (currentState->state == this->finalState) {
         this->depth = traceSolution(solution, currentState);
+        path.clear();
+        for (IDFSNode* node : solution) { // Os nós estão na pilha da recursão: copia os estados
+            path.push_back(node->state);
+        }
         return this->depth;
     }
         
         // Verificando profundidade
         if (maxDepth > 0) {
-		// Gerando filhos do estado atual
-		    currentState->moveUp();
-            currentState->moveLeft();
-            currentState->moveRight();
-            currentState->moveDown();
-            
-        	this->nodesCount++; 
+        	this->stats.expanded++; 
 			  
-            // iterando filhos
-			for (IDFSNode* child : currentState->children) {
-				// evitando ciclos verificando o pai
-				if(currentState->parent != nullptr && child->initialVector == currentState->parent->initialVector){
+            // iterando filhos sem montá-los antes das verificações
+			for (const Successor& next : Successors(currentState->state)) {
+				// evitando desfazer o último movimento e repetir transposições, sem comparar estados
+				int childFsm = MovePruning::transpositions().next(fsmState, next.move);
+				if(childFsm == MovePruning::PRUNED){
+					stats.duplicates++;
 					continue;	
 				}
 				
-				// verificando se o filho já foi visitado
-				bool alreadyVisited = false;
-				
-				for (IDFSNode* visitedNode: solution){
-					if (visitedNode->initialVector == child->initialVector){
-						alreadyVisited = true;
-						break;
-					}
-				}
-				
-				// se o filho já foi visitado, ignora e continua
-				if(alreadyVisited){
-					continue;
-				}
-				
-				// criando cópia do filho
-                IDFSNode* childCopy = new IDFSNode(child->initialVector, currentState);
+				// criando o filho na pilha, ligado ao nó atual
+                IDFSNode child(next.state(), currentState);
+                stats.generated++;
+                stats.noteOpen(depth - maxDepth + 1); // Profundidade do filho nesta iteração
                 
                 // realizando a busca em profundidade recursiva
-                objective = recursive_idfs(maxDepth -1, childCopy);
+                objective = recursive_idfs(maxDepth -1, &child, childFsm);
                 
                 //retornando objetivo se o mesmo foi encontrado
                 if(objective != -1){
                 	return objective;
 				}
-				
-				// adicionando filho a solução
-				solution.push_back(child);
-				
-				// limpando memória alocada para o filho
-				delete childCopy;                    
             }            
         }
         return -1;
@@ -218,23 +149,9 @@ int IDFSPuzzle::recursive_idfs(int maxDepth, IDFSNode* currentState) {
     return -1; // Se não encontrou solução, retorna -1
 }*/
 
-// Função para calcular a distância de Manhattan de uma matriz 3x3
 // Calcula a distância de Manhattan entre um estado atual e um estado objetivo
-int manhattanDistanceIDFS(const std::vector<int>& state, const std::vector<int>& goal) {
-    int distance = 0; // Inicializa a distância em zero
-    // Percorre cada elemento do vetor de estado para calcular a distância de Manhattan
-    for (size_t i = 0; i < state.size(); ++i) {
-        if (state[i] != 0) { // Ignora o espaço vazio
-            // Determina a posição correspondente no vetor objetivo
-            int goalPos = static_cast<int>(std::distance(goal.begin(), std::find(goal.begin(), goal.end(), state[i])));
-            // Calcula a diferença de linhas
-            int rowDistance = std::abs(static_cast<int>(i / 3) - (goalPos / 3));
-            // Calcula a diferença de colunas
-            int colDistance = std::abs(static_cast<int>((i % 3) - (goalPos % 3)));
-            distance += rowDistance + colDistance; // Soma as distâncias de linha e coluna
-        }
-    }
-    return distance; // Retorna a distância total calculada
+int manhattanDistanceIDFS(const PuzzleState& state, const PuzzleState& goal) {
+    return ManhattanTable(goal).evaluate(state); // Monta a tabela do objetivo e soma as distâncias
 }
 
 int manhattan_distance_matrix(int puzzle[3][3]) {
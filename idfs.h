@@ -3,25 +3,21 @@
 
 #include <iostream>
 #include <vector>
-#include <map>
-#include <queue>
 #include <algorithm>
+#include "puzzlestate.h"
+#include "manhattan.h"
+#include "successors.h"
+#include "movepruning.h"
+#include "searchstats.h"
 
 // Declaração da classe Node
 class IDFSNode {
 public:
-    std::vector<IDFSNode*> children; // Filhos do nó
-    std::vector<int> initialVector; // Estado do quebra-cabeça
+    PuzzleState state; // Estado do quebra-cabeça
     IDFSNode* parent; // Ponteiro para o nó pai
 
     // Construtor do Node
-    IDFSNode(const std::vector<int>& _initialVector, IDFSNode* _parent = nullptr);
-
-    // Métodos para movimentos do zero no quebra-cabeça
-    void moveUp(); // Mover para cima
-    void moveDown(); // Mover para baixo
-    void moveRight(); // Mover para a direita
-    void moveLeft(); // Mover para a esquerda
+    IDFSNode(const PuzzleState& _state, IDFSNode* _parent = nullptr);
 
     // Função para encontrar a posição do zero
     int findZero() const;
@@ -36,27 +32,27 @@ int traceSolution(std::vector<IDFSNode*>& solution, IDFSNode* goal);
 // Declaração da classe Puzzle para resolver o quebra-cabeça usando IDFS
 class IDFSPuzzle {
 private:
-    std::queue<IDFSNode*> queue; // Fila de nós não explorados
-    std::map<std::vector<int>, bool> visited; // Estados visitados
-    std::vector<int> finalVector; // Estado final do quebra-cabeça
+    PuzzleState finalState; // Estado final do quebra-cabeça
 
 public:
     int depth; // Profundidade da solução
-    int nodesCount; // Número de nós explorados
+    SearchStats stats; // Nós explorados, gerados e podados, com os contadores de cada profundidade
+    std::vector<PuzzleState> path; // Estados da solução, do início ao objetivo
     
     // Construtor do Puzzle
-    IDFSPuzzle(const std::vector<int>& _initialVector, const std::vector<int>& _finalVector);
+    explicit IDFSPuzzle(const std::vector<int>& _finalVector);
 
     // Método para busca IDFS
     int IDFS(const std::vector<int>& initialVector);
 
-    // Função recursiva para busca de profundidade limitada
-    int recursive_idfs(int maxDepth, IDFSNode* currentState);
+    // Função recursiva para busca de profundidade limitada; fsmState é o estado do
+    // autômato de poda de movimentos depois do caminho até currentState
+    int recursive_idfs(int maxDepth, IDFSNode* currentState, int fsmState = MovePruning::START);
 };
 
 // Função para calcular a distância de Manhattan
 int manhattan_distance_matrix(int puzzle[3][3]);
 
-int manhattanDistanceIDFS(const std::vector<int>& state, const std::vector<int>& goal);
+int manhattanDistanceIDFS(const PuzzleState& state, const PuzzleState& goal);
 
 #endif // IDFS_H
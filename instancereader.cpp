@@ -0,0 +1,230 @@
+#include "instancereader.h"
+#include "binaryformat.h"
+#include <cstring>
+
+InstanceReader::InstanceReader(int _cells)
+    : cells(_cells), stream(nullptr), ownsStream(false), cursor(nullptr), end(nullptr), finished(true), binary(false), fileCells(0),
+      lineCount(0), errorCount(0), errorLine(0) {}
+
+InstanceReader::~InstanceReader() {
+    close();
+}
+
+bool InstanceReader::open(const std::string& path) {
+    close();
+    lineCount = 0;
+    errorCount = 0;
+    errorLine = 0;
+    if (path != "-" && file.open(path)) {
+        cursor = reinterpret_cast<const char*>(file.data());
+        end = cursor + file.size();
+        finished = true; // O arquivo inteiro já está disponível
+        return readHeader();
+    }
+    if (path == "-") {
+        stream = stdin;
+    } else {
+        stream = std::fopen(path.c_str(), "rb"); // Arquivo vazio, pipe ou sem suporte a mmap
+        ownsStream = true;
+        if (!stream) {
+            return false;
+        }
+    }
+    buffer.resize(CHUNK_SIZE);
+    cursor = end = buffer.data();
+    finished = false;
+    refill(); // O primeiro bloco diz se o formato é binário
+    return readHeader();
+}
+
+bool InstanceReader::readHeader() {
+    binary = static_cast<size_t>(end - cursor) >= INSTANCE_HEADER_SIZE && std::memcmp(cursor, INSTANCE_MAGIC, 4) == 0;
+    if (!binary) {
+        return true;
+    }
+    int headerCells = static_cast<unsigned char>(cursor[4]);
+    cursor += INSTANCE_HEADER_SIZE;
+    fileCells = headerCells;
+    if (headerCells == 0) { // Lote vazio
+        cursor = end;
+        finished = true;
+        return true;
+    }
+    if ((headerCells != 9 && headerCells != 16) || (cells != 0 && headerCells != cells)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void InstanceReader::close() {
+    file.close();
+    if (stream && ownsStream) {
+        std::fclose(stream);
+    }
+    stream = nullptr;
+    ownsStream = false;
+    cursor = end = nullptr;
+    finished = true;
+    binary = false;
+}
+
+bool InstanceReader::refill() {
+    // Move a linha incompleta para o início e completa o bloco com uma nova leitura
+    // (antes de crescer o buffer: o resize invalidaria cursor)
+    size_t pending = static_cast<size_t>(end - cursor);
+    if (pending > 0) {
+        std::memmove(buffer.data(), cursor, pending);
+    }
+    if (pending == buffer.size()) {
+        buffer.resize(buffer.size() * 2); // Linha maior que o bloco
+    }
+    size_t count = std::fread(buffer.data() + pending, 1, buffer.size() - pending, stream);
+    cursor = buffer.data();
+    end = cursor + pending + count;
+    if (count == 0) {
+        finished = true;
+    }
+    return count > 0;
+}
+
+bool InstanceReader::nextLine(const char*& lineBegin, const char*& lineEnd) {
+    while (true) {
+        const char* newline = cursor == end ? nullptr : static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (newline) {
+            lineBegin = cursor;
+            lineEnd = newline;
+            cursor = newline + 1;
+            return true;
+        }
+        if (finished || !refill()) {
+            if (cursor == end) {
+                return false;
+            }
+            lineBegin = cursor; // Última linha, sem quebra no fim
+            lineEnd = end;
+            cursor = end;
+            return true;
+        }
+    }
+}
+
+// Lê os inteiros da linha direto para as peças compactadas
+bool InstanceReader::parse(const char* begin, const char* finish, int cells, PuzzleState& state) {
+    uint64_t tiles = 0;
+    uint32_t seen = 0; // Peças já encontradas
+    int count = 0;
+    int zero = 0;
+    const char* p = begin;
+    while (true) {
+        while (p < finish && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',')) {
+            ++p;
+        }
+        if (p == finish) {
+            break;
+        }
+        if (*p < '0' || *p > '9' || count == 16) {
+            return false;
+        }
+        int value = 0;
+        while (p < finish && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > 15) {
+                return false;
+            }
+            ++p;
+        }
+        if (seen & (1u << value)) {
+            return false;
+        }
+        seen |= 1u << value;
+        tiles |= static_cast<uint64_t>(value) << (4 * count);
+        if (value == 0) {
+            zero = count;
+        }
+        count++;
+    }
+    if ((count != 9 && count != 16) || (cells != 0 && count != cells) || seen != (1u << count) - 1) {
+        return false;
+    }
+    state.tiles = tiles;
+    state.zero = static_cast<uint8_t>(zero);
+    state.cells = static_cast<uint8_t>(count);
+    state.width = static_cast<uint8_t>(count == 9 ? 3 : 4);
+    return true;
+}
+
+// Confere um estado compactado lido do formato binário
+bool InstanceReader::unpack(uint64_t tiles, PuzzleState& state) const {
+    int count = fileCells;
+    if (count < 16 && (tiles >> (4 * count)) != 0) {
+        return false;
+    }
+    uint32_t seen = 0;
+    int zero = 0;
+    for (int pos = 0; pos < count; ++pos) {
+        int value = static_cast<int>((tiles >> (4 * pos)) & 0xF);
+        seen |= 1u << value;
+        if (value == 0) {
+            zero = pos;
+        }
+    }
+    if (seen != (1u << count) - 1) {
+        return false;
+    }
+    state.tiles = tiles;
+    state.zero = static_cast<uint8_t>(zero);
+    state.cells = static_cast<uint8_t>(count);
+    state.width = static_cast<uint8_t>(count == 9 ? 3 : 4);
+    return true;
+}
+
+bool InstanceReader::nextRecord(PuzzleState& state) {
+    while (true) {
+        if (static_cast<size_t>(end - cursor) < INSTANCE_RECORD_SIZE && !finished) {
+            refill();
+            continue;
+        }
+        if (static_cast<size_t>(end - cursor) < INSTANCE_RECORD_SIZE) {
+            if (cursor != end) { // Registro incompleto no fim do arquivo
+                cursor = end;
+                errorCount++;
+                errorLine = ++lineCount;
+            }
+            return false;
+        }
+        uint64_t tiles;
+        std::memcpy(&tiles, cursor, INSTANCE_RECORD_SIZE);
+        cursor += INSTANCE_RECORD_SIZE;
+        lineCount++;
+        if (unpack(tiles, state)) {
+            return true;
+        }
+        errorCount++;
+        errorLine = lineCount;
+    }
+}
+
+bool InstanceReader::next(PuzzleState& state) {
+    if (binary) {
+        return nextRecord(state);
+    }
+    const char* lineBegin;
+    const char* lineEnd;
+    while (nextLine(lineBegin, lineEnd)) {
+        lineCount++;
+        const char* p = lineBegin;
+        while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            ++p;
+        }
+        if (p == lineEnd) {
+            continue; // Linha vazia
+        }
+        if (parse(p, lineEnd, cells, state)) {
+            return true;
+        }
+        errorCount++;
+        errorLine = lineCount;
+    }
+    return false;
+}
@@ -0,0 +1,69 @@
+#ifndef INSTANCEREADER_H
+#define INSTANCEREADER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "puzzlestate.h"
+#include "mappedfile.h"
+
+// Leitor de instâncias em fluxo: uma instância por linha, com as peças separadas por
+// espaços, ou o formato binário de binaryformat.h, reconhecido pelo cabeçalho. Arquivos comuns são mapeados com mmap e lidos sem cópia; a entrada padrão
+// ("-"), pipes e arquivos que não podem ser mapeados são lidos em blocos. Cada linha é
+// convertida direto para o estado compactado, sem passar por strings ou vetores.
+class InstanceReader {
+public:
+    static const size_t CHUNK_SIZE = 1 << 16; // Bytes por leitura quando não há mmap
+
+    // cells: número de peças esperado por linha (0 aceita 9 ou 16)
+    explicit InstanceReader(int _cells = 0);
+    ~InstanceReader();
+
+    InstanceReader(const InstanceReader&) = delete;
+    InstanceReader& operator=(const InstanceReader&) = delete;
+
+    // Retorna false se o arquivo não pôde ser aberto ou se o cabeçalho binário não é do
+    // tamanho esperado; zera as contagens
+    bool open(const std::string& path);
+    void close();
+
+    // Próxima instância; false no fim da entrada. Linhas vazias são ignoradas e linhas
+    // inválidas (número de peças errado, peça repetida ou fora do tabuleiro) são puladas
+    // e contadas em errors(), com o número da última delas em lastErrorLine(). No
+    // formato binário cada registro conta como uma linha.
+    bool next(PuzzleState& state);
+
+    // Converte as peças de uma linha de texto [begin, finish) para o estado compactado;
+    // false se a linha não for um tabuleiro válido de cells peças (0 aceita 9 ou 16)
+    static bool parse(const char* begin, const char* finish, int cells, PuzzleState& state);
+
+    size_t lineNumber() const { return lineCount; } // Linhas lidas até agora
+    size_t errors() const { return errorCount; }
+    size_t lastErrorLine() const { return errorLine; }
+    bool isMapped() const { return file.data() != nullptr; }
+    bool isBinary() const { return binary; } // Válido depois de open
+
+private:
+    int cells;
+    MappedFile file;
+    std::FILE* stream; // Entrada lida em blocos (nullptr com mmap)
+    bool ownsStream; // false para a entrada padrão
+    std::vector<char> buffer; // Bloco atual, mais o resto da linha do bloco anterior
+    const char* cursor; // Início da próxima linha
+    const char* end; // Fim dos dados disponíveis
+    bool finished; // Não há mais dados para ler
+    bool binary; // Registros de 8 bytes em vez de linhas de texto
+    int fileCells; // Tamanho do tabuleiro declarado no cabeçalho binário
+    size_t lineCount;
+    size_t errorCount;
+    size_t errorLine;
+
+    bool nextLine(const char*& lineBegin, const char*& lineEnd);
+    bool refill(); // Lê mais um bloco, preservando a linha incompleta
+    bool readHeader(); // Reconhece o cabeçalho binário; false se ele for inválido
+    bool nextRecord(PuzzleState& state);
+    bool unpack(uint64_t tiles, PuzzleState& state) const;
+};
+
+#endif // INSTANCEREADER_H
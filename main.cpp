@@ -1,196 +1,335 @@
-#include "astar.h"
-#include "gbfs.h"
-#include "bfs.h"
-#include "idfs.h"
-#include "idastar.h"
-#include "astar15.h"
+#include "solver.h"
+#include "manhattan.h"
+#include "pdb.h"
+#include "oracle.h"
+#include "heuristic.h"
+#include "batch.h"
+#include "instancereader.h"
+#include "binaryformat.h"
+#include "server.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <chrono>
 #include <cstring> // Para comparar strings C
+#include <cstdlib> // Para std::atoi
+#include <thread>
+#include <algorithm>
 
 int main(int argc, char* argv[]) {
     if (argc < 2) { // Verifica se ao menos um argumento foi fornecido
-        std::cerr << "Uso: " << argv[0] << " <algoritmo>\n";
-        std::cerr << "Algoritmos disponíveis: -bfs, -gbfs, -astar, -idastar\n";
+        std::cerr << "Uso: " << argv[0] << " <algoritmo> [8|15] [-pdb arquivo] [-table arquivo] [-bidirectional] [-heuristic nome] [-tt MB] [-ithreads n] [-j threads] [-input arquivo]... [-stream] [-output arquivo] [-stats json|csv] [-socket arquivo] [-connect arquivo]\n";
+        std::cerr << "Algoritmos disponíveis:";
+        for (const SolverInfo& info : solverRegistry()) {
+            std::cerr << " " << info.flag << ",";
+        }
+        std::cerr << " -buildpdb, -buildoracle, -convert, -serve\n";
+        std::cerr << "O segundo argumento escolhe o tamanho do tabuleiro (padrão: 8, ou 15 para -astar15 e -hdastar)\n";
+        std::cerr << "-pdb usa o banco de padrões do 15-puzzle gerado por -buildpdb em -astar 15, -gbfs 15, -idastar 15, -astar15 e -hdastar\n";
+        std::cerr << "-table usa (ou, com -buildoracle, grava) a tabela de distâncias do 8-puzzle em -oracle (padrão: 8puzzle.oracle)\n";
+        std::cerr << "-bidirectional faz o -bfs buscar a partir do início e do objetivo ao mesmo tempo\n";
+        std::cerr << "-heuristic escolhe a heurística de -astar, -gbfs, -idastar, -astar15 e -hdastar: manhattan, lc (conflito linear) ou pdb\n";
+        std::cerr << "-tt liga a tabela de transposição do -idastar com o tamanho dado em MB e mostra suas estatísticas\n";
+        std::cerr << "-ithreads divide cada busca do -idastar ou do -hdastar entre n threads e mostra os nós por thread (padrão: 1 no -idastar; no -hdastar, as threads de -j, resolvendo uma instância por vez)\n";
+        std::cerr << "-input lê as instâncias do arquivo dado, ou da entrada padrão com '-'; pode ser repetido (padrão: input/8puzzle_instances.txt ou input/15puzzle_instances.txt)\n";
+        std::cerr << "-stream começa a resolver enquanto as instâncias ainda são lidas, na ordem de chegada, em vez de ler o lote inteiro antes\n";
+        std::cerr << "-output grava os resultados no formato binário de registros fixos em vez de texto na saída padrão\n";
+        std::cerr << "-stats troca as linhas de resultado pelas estatísticas da busca em JSON (um objeto por linha) ou CSV: nós expandidos, gerados, duplicados e reabertos, picos das listas, memória, nós/s e as iterações do -idastar e do -idfs\n";
+        std::cerr << "-convert converte o arquivo de -input entre texto e binário (instâncias) ou de binário para texto (resultados), gravando em -output\n";
+        std::cerr << "-serve atende pedidos \"id algoritmo peças...\" pela entrada padrão, ou pelo socket Unix de -socket, mantendo as tabelas carregadas entre eles\n";
+        std::cerr << "-connect envia as instâncias ao servidor no socket dado em vez de resolvê-las localmente\n";
+        std::cerr << "-j define o número de threads de -buildpdb e do lote de instâncias, resolvidas em paralelo (padrão: todos os núcleos)\n";
         return 1; // Retorna erro se nenhum argumento for fornecido
     }
 
     std::string algoritmo = argv[1]; // Obtém o argumento do algoritmo
 
-    if (algoritmo != "-bfs" && algoritmo != "-gbfs" && algoritmo != "-astar" && algoritmo != "-idastar" && algoritmo != "-idfs" && algoritmo != "-astar15") {
-        std::cerr << "Algoritmo não reconhecido. Use '-bfs', '-gbfs', '-idfs', '-astar15', '-idastar' ou '-astar'.\n";
+    const SolverInfo* solverInfo = findSolver(algoritmo); // Nulo nos comandos que não resolvem instâncias
+    if (!solverInfo && algoritmo != "-buildpdb" && algoritmo != "-buildoracle" && algoritmo != "-convert" && algoritmo != "-serve") {
+        std::cerr << "Algoritmo não reconhecido. Use";
+        for (const SolverInfo& info : solverRegistry()) {
+            std::cerr << " '" << info.flag << "',";
+        }
+        std::cerr << " '-buildpdb', '-buildoracle', '-convert' ou '-serve'.\n";
         return 1; // Retorna erro se o argumento não for um dos algoritmos esperados
     }
 
-
-
-    std::ifstream inputFile("input/8puzzle_instances.txt"); // Abre o arquivo de entrada
-
-	std::ifstream inputFile2("input/15puzzle_instances.txt"); // Abre o arquivo de entrada
-
-
-    if (!inputFile.is_open()) { 
-        std::cerr << "Erro ao abrir o arquivo de entrada." << std::endl;
-        return 1; // Retorna erro se não conseguir abrir o arquivo
+    // Tamanho do quebra-cabeça: todos os algoritmos rodam tanto no 8-puzzle quanto no 15-puzzle
+    int puzzleSize = (solverInfo ? solverInfo->defaultSize : (algoritmo == "-buildpdb" ? 15 : 8));
+    std::string pdbPath; // Arquivo do banco de padrões
+    std::string oraclePath = "8puzzle.oracle"; // Arquivo da tabela de distâncias do 8-puzzle
+    size_t transpositionBytes = 0; // Memória da tabela de transposição do IDA* (-tt, 0 desliga)
+    int searchThreads = 0; // Threads por busca do IDA* ou do HDA* (-ithreads; 0 = padrão do algoritmo)
+    bool bidirectional = false; // BFS bidirecional (-bidirectional)
+    std::vector<std::string> inputPaths; // Arquivos de instâncias (-input; "-" é a entrada padrão)
+    bool stream = false; // Resolve as instâncias enquanto elas são lidas (-stream)
+    std::string socketPath; // Socket Unix do servidor (-socket; vazio: entrada e saída padrão)
+    std::string connectPath; // Servidor que resolve as instâncias (-connect)
+    std::string outputPath; // Arquivo de resultados binário (-output; vazio: texto na saída padrão)
+    std::string statsFormat; // Estatísticas no lugar das linhas de resultado (-stats json ou csv)
+    std::string heuristicName; // Heurística pedida com -heuristic (vazio: pdb se houver -pdb, senão manhattan)
+    int threads = static_cast<int>(std::thread::hardware_concurrency()); // Linhas de execução (-j)
+    if (threads < 1) {
+        threads = 1;
     }
-    if (!inputFile2.is_open()) { 
-        std::cerr << "Erro ao abrir o arquivo de entrada." << std::endl;
-        return 1; // Retorna erro se não conseguir abrir o arquivo
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-pdb" && i + 1 < argc) {
+            pdbPath = argv[++i];
+        } else if (arg == "-table" && i + 1 < argc) {
+            oraclePath = argv[++i];
+        } else if (arg == "-bidirectional") {
+            bidirectional = true;
+        } else if (arg == "-heuristic" && i + 1 < argc) {
+            heuristicName = argv[++i];
+        } else if (arg == "-tt" && i + 1 < argc) {
+            transpositionBytes = static_cast<size_t>(std::max(0, std::atoi(argv[++i]))) << 20;
+        } else if (arg == "-ithreads" && i + 1 < argc) {
+            searchThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-input" && i + 1 < argc) {
+            inputPaths.push_back(argv[++i]);
+        } else if (arg == "-output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "-socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "-connect" && i + 1 < argc) {
+            connectPath = argv[++i];
+        } else if (arg == "-stats" && i + 1 < argc) {
+            statsFormat = argv[++i];
+        } else if (arg == "-stream") {
+            stream = true;
+        } else if (arg == "-j" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else {
+            puzzleSize = std::atoi(argv[i]);
+        }
     }
-
-    std::string line; 
-    std::vector<std::vector<int>> initialStates;
-	std::vector<std::vector<int>> initialStates2;
-    // Lê os estados iniciais do arquivo
-    while (std::getline(inputFile, line)) {
-        std::istringstream iss(line);
-        std::vector<int> initialState;
-        int num;
-
-        while (iss >> num) {
-            initialState.push_back(num);
+    int batchThreads = threads; // Instâncias resolvidas ao mesmo tempo
+    if (searchThreads == 0) {
+        if (algoritmo == "-hdastar") { // O HDA* usa todas as threads em uma instância por vez
+            searchThreads = threads;
+            batchThreads = 1;
+        } else {
+            searchThreads = 1;
         }
-
-        initialStates.push_back(initialState); // Adiciona o estado inicial ao vetor
-    }
-    
-     // Lê os estados iniciais do arquivo
-    while (std::getline(inputFile2, line)) {
-        std::istringstream iss(line);
-        std::vector<int> initialState2;
-        int num;
-
-        while (iss >> num) {
-            initialState2.push_back(num);
+    }
+    if (!statsFormat.empty() && statsFormat != "json" && statsFormat != "csv") {
+        std::cerr << "Formato de estatísticas não suportado. Use json ou csv.\n";
+        return 1;
+    }
+    if (!statsFormat.empty() && (!outputPath.empty() || !connectPath.empty())) {
+        std::cerr << "-stats não combina com -output nem com -connect: as estatísticas só existem em texto, e o servidor não as envia.\n";
+        return 1;
+    }
+    if (puzzleSize != 8 && puzzleSize != 15) {
+        std::cerr << "Tamanho não suportado. Use 8 ou 15.\n";
+        return 1;
+    }
+    if (algoritmo == "-convert") { // Só converte o arquivo, sem resolver nada
+        if (inputPaths.size() != 1 || outputPath.empty()) {
+            std::cerr << "-convert precisa de um -input e de um -output.\n";
+            return 1;
         }
-
-        initialStates2.push_back(initialState2); // Adiciona o estado inicial ao vetor
+        return convertFile(inputPaths[0], outputPath, std::cerr) ? 0 : 1;
+    }
+    if ((algoritmo == "-oracle" || algoritmo == "-buildoracle") && puzzleSize != 8) {
+        std::cerr << "O oráculo de distâncias só cobre o 8-puzzle.\n";
+        return 1;
     }
-
-    inputFile.close(); // Fecha o arquivo
 
     std::vector<int> finalState = {0, 1, 2, 3, 4, 5, 6, 7, 8}; // Estado final do 8-puzzle
     std::vector<int> finalState15 = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}; // Estado final do 15-puzzle
 
-    for (const auto& initialState : initialStates) {
-        if (algoritmo == "-astar") {
-            Astar astar(finalState);
-            auto start_time = std::chrono::high_resolution_clock::now();
+    AdditivePDB pdb; // Banco de padrões aditivo do 15-puzzle
+    if (algoritmo == "-buildpdb") { // Gera o banco de padrões 6-6-3 e grava no arquivo
+        if (pdbPath.empty()) {
+            pdbPath = "15puzzle_663.pdb";
+        }
+        auto start_time = std::chrono::high_resolution_clock::now();
+        pdb.build(PuzzleState(finalState15), AdditivePDB::defaultPartition15(), threads, &std::cerr);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        if (!pdb.save(pdbPath)) {
+            std::cerr << "Erro ao gravar o banco de padrões em " << pdbPath << std::endl;
+            return 1;
+        }
+        std::cout << "PDB: " << pdbPath << ", " << pdb.bytes() << " bytes, "
+                  << std::chrono::duration<double>(end_time - start_time).count() << " s" << std::endl;
+        return 0;
+    }
+    DistanceOracle oracle; // Distâncias exatas de todos os estados do 8-puzzle
+    if (algoritmo == "-buildoracle") { // Gera a tabela por BFS retrógrada e grava no arquivo
+        auto start_time = std::chrono::high_resolution_clock::now();
+        oracle.build(PuzzleState(finalState));
+        auto end_time = std::chrono::high_resolution_clock::now();
+        if (!oracle.save(oraclePath)) {
+            std::cerr << "Erro ao gravar a tabela de distâncias em " << oraclePath << std::endl;
+            return 1;
+        }
+        std::cout << "Oracle: " << oraclePath << ", " << oracle.bytes() << " bytes, "
+                  << std::chrono::duration<double>(end_time - start_time).count() << " s" << std::endl;
+        return 0;
+    }
+    if (algoritmo == "-oracle") { // Mapeia a tabela gerada anteriormente
+        if (!oracle.load(oraclePath) || !oracle.matches(PuzzleState(finalState))) {
+            std::cerr << "Tabela de distâncias inválida para o 8-puzzle: " << oraclePath << " (gere-a com -buildoracle)" << std::endl;
+            return 1;
+        }
+    }
+    // O servidor carrega a tabela se ela existir; sem ela, só os pedidos de -oracle falham
+    bool oracleReady = algoritmo == "-oracle" || (algoritmo == "-serve" && oracle.load(oraclePath) && oracle.matches(PuzzleState(finalState)));
+    if (!pdbPath.empty()) { // Mapeia o banco de padrões gerado anteriormente
+        if (!pdb.load(pdbPath) || (puzzleSize != 15 && algoritmo != "-serve") || !pdb.matches(PuzzleState(finalState15))) {
+            std::cerr << "Banco de padrões inválido para o 15-puzzle: " << pdbPath << " (gere-o com -buildpdb)" << std::endl;
+            return 1;
+        }
+    }
+    HeuristicType heuristicType = pdb.empty() ? HEURISTIC_MANHATTAN : HEURISTIC_PDB;
+    if (!heuristicName.empty() && !parseHeuristic(heuristicName, heuristicType)) {
+        std::cerr << "Heurística não reconhecida. Use 'manhattan', 'lc' ou 'pdb'.\n";
+        return 1;
+    }
+    if (heuristicType == HEURISTIC_PDB && pdb.empty()) {
+        std::cerr << "A heurística pdb precisa de -pdb arquivo.\n";
+        return 1;
+    }
 
-            auto solutionPath = astar.findSolution(initialState);
+    SolverOptions options;
+    options.heuristic = heuristicType;
+    options.pdb = &pdb;
+    options.oracle = oracleReady ? &oracle : nullptr;
+    options.transpositionBytes = transpositionBytes;
+    options.searchThreads = searchThreads;
+    options.bidirectional = bidirectional;
+
+    if (algoritmo == "-serve") { // Atende pedidos até o fim da entrada ou até ser encerrado
+        SolverServer server(options, threads);
+        if (socketPath.empty()) {
+            server.serveStream(0, 1);
+            std::cerr << "Servidor: " << server.requestsServed() << " pedidos atendidos" << std::endl;
+            return 0;
+        }
+        std::cerr << "Servidor escutando em " << socketPath << " com " << threads << " threads" << std::endl;
+        server.serveSocket(socketPath);
+        std::cerr << "Erro ao escutar no socket " << socketPath << std::endl;
+        return 1;
+    }
 
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
+    // Para o 15-puzzle, os algoritmos genéricos usam o objetivo de 4x4; o -astar15 é sempre do 15-puzzle
+    bool fifteen = puzzleSize == 15 || algoritmo == "-astar15";
+    if (fifteen) {
+        finalState = finalState15;
+    }
+    // Só o arquivo de instâncias do tamanho escolhido é aberto
+    if (inputPaths.empty()) {
+        inputPaths.push_back(fifteen ? "input/15puzzle_instances.txt" : "input/8puzzle_instances.txt");
+    }
 
-            if (!solutionPath.empty()) {
-                std::cout << "A*: " << astar.getNodesCount() << ", " << (solutionPath.size() - 1) << ", " 
-                          << duration_sec << ", " << astar.getHeuristicAverage() << ", " 
-                          << astar.getStartHeuristic() << std::endl;
-            } else {
-                std::cout << "A*: Nenhuma solução encontrada." << std::endl;
+    // Lê as instâncias dos arquivos em sequência; linhas inválidas são avisadas e puladas
+    InstanceReader reader(fifteen ? 16 : 9);
+    size_t nextInput = 0;
+    bool readerOpen = false;
+    bool inputFailed = false; // Algum arquivo não pôde ser aberto
+    auto readInstance = [&](PuzzleState& state) {
+        while (true) {
+            if (readerOpen && reader.next(state)) {
+                return true;
             }
-        } else if (algoritmo == "-gbfs") {
-            GBFS gbfs(finalState);
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            auto solutionPath = gbfs.solve(initialState);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
-
-            if (!solutionPath.empty()) {
-                std::cout << "GBFS: " << gbfs.getNodesCount() << ", " << (solutionPath.size() - 1) << ", " 
-                          << duration_sec << ", " << gbfs.getHeuristicAverage() << ", " 
-                          << gbfs.getStartHeuristic() << std::endl;
-            } else {
-                std::cout << "GBFS: Nenhuma solução encontrada." << std::endl;
+            if (readerOpen) {
+                if (reader.errors() > 0) {
+                    std::cerr << "Aviso: " << reader.errors() << " linha(s) inválida(s) ignorada(s) em "
+                              << inputPaths[nextInput - 1] << " (a última na linha " << reader.lastErrorLine() << ")" << std::endl;
+                }
+                reader.close();
+                readerOpen = false;
             }
-        } else if (algoritmo == "-bfs") {
-            BFS bfs(finalState);
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            auto solutionPath = bfs.solve(initialState);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
-
-            if (!solutionPath.empty()) {
-                std::cout << "BFS: " << bfs.getNodesCount() << ", " << (solutionPath.size() - 1) << ", " 
-                          << duration_sec << ", 0, " 
-                          << bfs.getSolutionDepth() << std::endl;
-            } else {
-                std::cout << "BFS: Nenhuma solução encontrada." << std::endl;
+            if (nextInput == inputPaths.size()) {
+                return false;
             }
-        }else if (algoritmo == "-idastar") { // Adicione a lógica do IDA*
-            IDAStar idaStar(finalState);
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            auto solutionPath = idaStar.idaStar(initialState);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
-
-            if (!solutionPath.empty()) {
-            	int a = idaStar.getNodesExpanded();
-            	float b = idaStar.heuristic_sum;
-                std::cout << "IDA*: " << idaStar.getNodesExpanded() << ", " 
-                          << (solutionPath.size() - 1) << ", " 
-                          << duration_sec << ", " 
-                          <<  b/a << ", " 
-                          << idaStar.getStartHeuristic() << std::endl;
-            } else {
-                std::cout << "IDA*: Nenhuma solução encontrada." << std::endl;
+            if (!reader.open(inputPaths[nextInput])) {
+                std::cerr << "Erro ao abrir o arquivo de entrada " << inputPaths[nextInput] << std::endl;
+                inputFailed = true;
+                return false;
             }
-        }else if(algoritmo == "-idfs"){
-        	
-		IDFSPuzzle puzzle(initialState, finalState15);
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            int depth = puzzle.IDFS(initialState);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            double duration_sec = std::chrono::duration<double>(end_time - start_time).count();
-			int distanceManhattan = manhattanDistanceIDFS(initialState, finalState);
-			
-            if (depth != -1) {
-                std::cout << "IDFS: " << puzzle.nodesCount << ", " << depth - 1 << ", " 
-                          << duration_sec << ", " 
-                          << "0, " << distanceManhattan << endl; 
-
-
+            nextInput++;
+            readerOpen = true;
+        }
+    };
+
+    // Cada thread do lote pega um solver ocioso, que mantém suas tabelas entre as instâncias
+    SolverPool solvers(*solverInfo, PuzzleState(finalState), options);
+    auto solveInstance = [&](const PuzzleState& state) {
+        return solvers.solve(state);
+    };
+
+    // Os resultados saem em texto na saída padrão ou em registros binários em -output, sempre
+    // por um buffer; em fluxo o texto é descarregado a cada linha, para não atrasar respostas
+    BufferedWriter textOutput;
+    ResultWriter resultOutput;
+    if (outputPath.empty()) {
+        textOutput.open("-");
+        if (statsFormat == "csv") {
+            textOutput.write(statsCsvHeader());
+        }
+    } else if (!resultOutput.open(outputPath, fifteen ? 16 : 9, fifteen ? 4 : 3)) {
+        std::cerr << "Erro ao criar o arquivo de resultados " << outputPath << std::endl;
+        return 1;
+    }
+    auto emitResult = [&](const SolveResult& result) {
+        if (outputPath.empty()) {
+            if (statsFormat == "json") {
+                textOutput.write(formatStatsJson(*solverInfo, result));
+            } else if (statsFormat == "csv") {
+                textOutput.write(formatStatsCsv(*solverInfo, result));
             } else {
-                std::cout << "IDFS: Nenhuma solução encontrada." << std::endl;
+                textOutput.write(formatResult(*solverInfo, result));
             }
-    	}
-		
-    }
-     for (const auto& initialState2 : initialStates2) {
-	 
-	 if (algoritmo == "-astar15") { // Novo caso para A* do 15-puzzle
-            A15Puzzle puzzle(finalState15); // Alvo do 15-puzzle
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            auto solutionPath = puzzle.Astar15(initialState2);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
-
-            if (!solutionPath.empty()) {
-                std::cout << "Astar15: " << puzzle.nodesCount << ", " 
-                          << (solutionPath.size() - 1) << ", " 
-                          << duration_sec << ", " 
-                          << puzzle.heuristicSum / puzzle.nodesCount << ", "
-                          << puzzle.startHeuristic << endl;
-            } else {
-                std::cout << "Astar15: Nenhuma solução encontrada." << std::endl;
+            if (stream || !connectPath.empty()) {
+                textOutput.flush();
             }
+        } else {
+            resultOutput.write(result.record);
         }
-	 
-	 }
-
+    };
+
+    auto batch_start = std::chrono::high_resolution_clock::now();
+    size_t instanceCount = 0;
+    if (!connectPath.empty()) { // O servidor resolve; as respostas chegam enquanto as instâncias são enviadas
+        long long sent = runClient(connectPath, *solverInfo, readInstance, emitResult, std::cerr);
+        if (sent < 0) {
+            std::cerr << "Erro ao conectar ao servidor em " << connectPath << std::endl;
+            return 1;
+        }
+        instanceCount = static_cast<size_t>(sent);
+    } else if (stream) { // As primeiras instâncias já são resolvidas enquanto as seguintes são lidas
+        instanceCount = runStream<PuzzleState>(readInstance, batchThreads, 4 * static_cast<size_t>(batchThreads), solveInstance, emitResult);
+    } else {
+        std::vector<PuzzleState> instances;
+        PuzzleState state;
+        while (readInstance(state)) {
+            instances.push_back(state);
+        }
+        // A distância de Manhattan estima a dificuldade de cada instância para a ordem do lote
+        ManhattanTable instanceCost{PuzzleState(finalState)};
+        std::vector<int> costs;
+        for (const PuzzleState& initialState : instances) {
+            costs.push_back(instanceCost.evaluate(initialState));
+        }
+        runBatch(instances.size(), batchThreads, costs, [&](size_t index) { return solveInstance(instances[index]); }, emitResult);
+        instanceCount = instances.size();
+    }
+    bool outputOk = outputPath.empty() ? textOutput.close() : resultOutput.close();
+    auto batch_end = std::chrono::high_resolution_clock::now();
+    double batch_sec = std::chrono::duration<double>(batch_end - batch_start).count();
+    std::cerr << "Lote: " << instanceCount << " instâncias em " << batch_sec << " s, "
+              << (batch_sec > 0 ? instanceCount / batch_sec : 0.0) << " instâncias/s, "
+              << batchThreads << " threads" << std::endl;
+
+    if (!outputOk) {
+        std::cerr << "Erro ao gravar os resultados" << std::endl;
+        return 1;
+    }
+    if (inputFailed) {
+        return 1;
+    }
     return 0; // Indica que o programa terminou com sucesso
 }
 
@@ -0,0 +1,59 @@
+#ifndef MANHATTAN_H
+#define MANHATTAN_H
+
+#include <cstdint>
+#include <cstdlib>
+#include "puzzlestate.h"
+
+// Tabela da distância de Manhattan de cada peça em cada posição, montada uma vez por
+// estado objetivo. Como um movimento desloca apenas uma peça, a heurística do filho
+// é a do pai somada à variação dessa peça (delta), em tempo constante.
+class ManhattanTable {
+public:
+    explicit ManhattanTable(const PuzzleState& goal) {
+        const MoveTable& board = moveTableFor(goal.width);
+        int cells = goal.cells;
+        for (int tile = 0; tile < 16; ++tile) {
+            for (int pos = 0; pos < 16; ++pos) {
+                table[tile][pos] = 0;
+            }
+        }
+        for (int goalPos = 0; goalPos < cells; ++goalPos) {
+            int tile = goal.at(goalPos);
+            if (tile == 0) {
+                continue; // O espaço vazio não conta na heurística
+            }
+            for (int pos = 0; pos < cells; ++pos) {
+                int rowDistance = std::abs(board.row[pos] - board.row[goalPos]);
+                int colDistance = std::abs(board.col[pos] - board.col[goalPos]);
+                table[tile][pos] = static_cast<uint8_t>(rowDistance + colDistance);
+            }
+        }
+    }
+
+    // Distância da peça tile estando na posição pos
+    int distance(int tile, int pos) const {
+        return table[tile][pos];
+    }
+
+    // Distância de Manhattan completa do estado (usada apenas na raiz)
+    int evaluate(const PuzzleState& state) const {
+        int distance = 0;
+        for (int i = 0; i < state.cells; ++i) {
+            distance += table[state.at(i)][i];
+        }
+        return distance;
+    }
+
+    // Variação da heurística quando o zero de state vai para newZero: a peça que estava
+    // em newZero passa para a antiga posição do zero
+    int delta(const PuzzleState& state, int newZero) const {
+        int tile = state.at(newZero);
+        return table[tile][state.zero] - table[tile][newZero];
+    }
+
+private:
+    uint8_t table[16][16]; // Distância por peça e posição
+};
+
+#endif // MANHATTAN_H
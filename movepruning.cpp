@@ -0,0 +1,172 @@
+#include "movepruning.h"
+#include "puzzledomain.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+// Efeito de uma sequência de movimentos num tabuleiro sem bordas, centrado na posição
+// inicial do zero: a posição final do zero e a peça que foi parar em cada posição
+// visitada. Também devolve as posições visitadas, em ordem.
+class EffectGrid {
+public:
+    explicit EffectGrid(int maxLength)
+        : size(2 * maxLength + 1), center(maxLength * size + maxLength), occupant(size * size) {
+        for (int i = 0; i < size * size; ++i) {
+            occupant[i] = i; // Cada posição começa com a sua própria peça
+        }
+        delta[MOVE_UP] = -size;
+        delta[MOVE_LEFT] = -1;
+        delta[MOVE_RIGHT] = 1;
+        delta[MOVE_DOWN] = size;
+    }
+
+    void apply(const std::string& moves, std::string& key, std::vector<int>& cells) {
+        int blank = center;
+        cells.assign(1, blank);
+        for (char m : moves) {
+            int next = blank + delta[static_cast<int>(m)];
+            std::swap(occupant[blank], occupant[next]);
+            blank = next;
+            cells.push_back(blank);
+        }
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+        // Chave: zero final e pares (posição, peça) das peças fora do lugar, 2 bytes cada
+        key.clear();
+        appendCell(key, blank);
+        for (int cell : cells) {
+            if (occupant[cell] != cell) {
+                appendCell(key, cell);
+                appendCell(key, occupant[cell]);
+                occupant[cell] = cell; // Desfaz para a próxima sequência
+            }
+        }
+    }
+
+private:
+    int size;
+    int center;
+    std::vector<int> occupant;
+    int delta[4];
+
+    static void appendCell(std::string& key, int cell) {
+        key.push_back(static_cast<char>(cell & 0xFF));
+        key.push_back(static_cast<char>(cell >> 8));
+    }
+};
+
+// Regras de até maxLength movimentos, cada uma como sequência de movimentos
+std::vector<std::string> generateRules(int maxLength) {
+    EffectGrid grid(maxLength);
+    std::unordered_map<std::string, std::vector<std::vector<int>>> seen; // Posições visitadas por efeito
+    std::unordered_set<std::string> ruleSet;
+    std::vector<std::string> rules;
+    std::string key;
+    std::vector<int> cells;
+
+    std::vector<std::string> level(1); // Sequências mantidas do comprimento atual, em ordem
+    grid.apply(level[0], key, cells);
+    seen[key].push_back(cells);
+    for (int length = 1; length <= maxLength; ++length) {
+        std::vector<std::string> next;
+        for (const std::string& prefix : level) {
+            for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) {
+                std::string moves = prefix + static_cast<char>(m);
+                // O prefixo não contém regras, então só um sufixo pode ser regra
+                bool pruned = false;
+                for (int k = 2; k <= length && !pruned; ++k) {
+                    pruned = ruleSet.count(moves.substr(length - k)) > 0;
+                }
+                if (pruned) {
+                    continue;
+                }
+                grid.apply(moves, key, cells);
+                std::vector<std::vector<int>>& earlier = seen[key];
+                bool duplicate = false;
+                for (const std::vector<int>& visited : earlier) {
+                    if (std::includes(cells.begin(), cells.end(), visited.begin(), visited.end())) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (duplicate) {
+                    ruleSet.insert(moves);
+                    rules.push_back(moves);
+                } else {
+                    earlier.push_back(cells);
+                    next.push_back(moves);
+                }
+            }
+        }
+        level.swap(next);
+    }
+    return rules;
+}
+
+} // namespace
+
+MovePruning::MovePruning(int maxLength) : ruleCount(0) {
+    std::vector<std::string> rules = generateRules(maxLength);
+    ruleCount = rules.size();
+
+    // Trie das regras
+    std::vector<int> child(4, -1);
+    std::vector<bool> terminal(1, false);
+    for (const std::string& rule : rules) {
+        int node = 0;
+        for (char m : rule) {
+            int& slot = child[node * 4 + m];
+            if (slot < 0) {
+                slot = static_cast<int>(terminal.size());
+                terminal.push_back(false);
+                child.insert(child.end(), 4, -1);
+            }
+            node = child[node * 4 + m];
+        }
+        terminal[node] = true;
+    }
+
+    // Ligações de falha em largura (Aho-Corasick): sem filho, a transição é a do sufixo
+    // mais longo que ainda é prefixo de alguma regra
+    int count = static_cast<int>(terminal.size());
+    std::vector<int> fail(count, 0);
+    transitions.assign(count * 4, 0);
+    std::vector<int> queue;
+    for (int m = 0; m < 4; ++m) {
+        int v = child[m];
+        transitions[m] = v < 0 ? 0 : v;
+        if (v >= 0) {
+            queue.push_back(v);
+        }
+    }
+    for (size_t i = 0; i < queue.size(); ++i) {
+        int u = queue[i];
+        terminal[u] = terminal[u] || terminal[fail[u]];
+        for (int m = 0; m < 4; ++m) {
+            int v = child[u * 4 + m];
+            if (v < 0) {
+                transitions[u * 4 + m] = transitions[fail[u] * 4 + m];
+            } else {
+                fail[v] = transitions[fail[u] * 4 + m];
+                transitions[u * 4 + m] = v;
+                queue.push_back(v);
+            }
+        }
+    }
+    for (int& target : transitions) {
+        if (terminal[target]) {
+            target = PRUNED;
+        }
+    }
+}
+
+const MovePruning& MovePruning::transpositions() {
+    static const MovePruning fsm(TRANSPOSITION_LENGTH);
+    return fsm;
+}
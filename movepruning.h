@@ -0,0 +1,46 @@
+#ifndef MOVEPRUNING_H
+#define MOVEPRUNING_H
+
+#include <cstddef>
+#include <vector>
+
+// Poda de movimentos das buscas em profundidade por um autômato finito (Taylor e Korf).
+// As regras são geradas automaticamente: sequências de movimentos do zero são
+// enumeradas em ordem (comprimento, depois movimento) num tabuleiro sem bordas, e uma
+// sequência que tem o mesmo efeito de outra menor, que passa só por posições que ela
+// também visita, vira regra. Se a maior é válida num tabuleiro, a menor também é, então
+// descartá-la nunca perde o caminho ótimo. Desfazer o último movimento é a regra de
+// comprimento 2; as demais são transposições: sequências com o mesmo efeito de outra
+// que vem antes na ordem e é mantida (por exemplo, o zero contornando um quadrado 2x2
+// por um lado ou pelo outro: LURDLU tem o efeito de ULDRUL e é podada). Com
+// TRANSPOSITION_LENGTH = 8 são 34 regras, 4 delas as de desfazer. Ciclos propriamente ditos, que devolvem o
+// tabuleiro ao mesmo estado, só aparecem com 12 movimentos e não são podados.
+//
+// O autômato (Aho-Corasick sobre as regras) avança um estado por movimento; a busca o
+// carrega junto com o caminho e não gera o filho quando a transição é PRUNED.
+class MovePruning {
+public:
+    static const int START = 0; // Estado antes do primeiro movimento
+    static const int PRUNED = -1; // O movimento completa uma sequência descartada
+    static const int TRANSPOSITION_LENGTH = 8; // Regras de transpositions() (com 10 poda um pouco mais, mas gerar leva ~0,2 s)
+
+    // Autômato com as regras de até maxLength movimentos
+    explicit MovePruning(int maxLength);
+
+    // Regras de até TRANSPOSITION_LENGTH movimentos (construído uma vez, na primeira chamada)
+    static const MovePruning& transpositions();
+
+    // Estado depois do movimento move (ver Move), ou PRUNED
+    int next(int state, int move) const {
+        return transitions[state * 4 + move];
+    }
+
+    size_t states() const { return transitions.size() / 4; }
+    size_t rules() const { return ruleCount; }
+
+private:
+    std::vector<int> transitions; // 4 transições por estado
+    size_t ruleCount;
+};
+
+#endif // MOVEPRUNING_H
@@ -1,26 +1,22 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include "puzzlestate.h"
 #include <vector>
 #include <iostream>
 
 class Node {
 public:
-    std::vector<int> initialVector;
+    PuzzleState state;
     Node* parent;
     int insertionOrder;
-    std::vector<Node*> children;
 
-    Node(std::vector<int> _initialVector, Node* _parent, int _insertionOrder);
+    Node(const PuzzleState& _state, Node* _parent, int _insertionOrder);
     
 	Node(std::vector<int> _initialVector, Node* _parent);
 
     int findZero();
     void printPuzzle();
-    void moveUp(int order);
-    void moveDown(int order);
-    void moveLeft(int order);
-    void moveRight(int order);
 
 };
 
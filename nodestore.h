@@ -0,0 +1,93 @@
+#ifndef NODESTORE_H
+#define NODESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "puzzlestate.h"
+
+// Nós de busca guardados como estrutura de vetores: peças compactadas, posição do zero,
+// índice do pai (32 bits) e movimento que gerou o nó ficam em vetores paralelos e cada
+// nó é referido pelo seu índice. São 14 bytes por nó, contra uns 56 de um nó com
+// ponteiro para o pai e vetor de filhos, e refazer o caminho é só seguir índices.
+class NodeStore {
+public:
+    static const uint32_t NO_PARENT = 0xFFFFFFFF;
+
+    // Esvazia o armazém (mantendo a capacidade) para uma busca a partir de root
+    void reset(const PuzzleState& root) {
+        tiles.clear();
+        zeros.clear();
+        parents.clear();
+        moves.clear();
+        width = root.width;
+        cells = root.cells;
+    }
+
+    // Acrescenta um nó e retorna seu índice
+    uint32_t add(const PuzzleState& state, uint32_t parent, int move) {
+        tiles.push_back(state.tiles);
+        zeros.push_back(state.zero);
+        parents.push_back(parent);
+        moves.push_back(static_cast<uint8_t>(move));
+        return static_cast<uint32_t>(tiles.size() - 1);
+    }
+
+    PuzzleState state(uint32_t index) const {
+        PuzzleState state;
+        state.tiles = tiles[index];
+        state.zero = zeros[index];
+        state.width = width;
+        state.cells = cells;
+        return state;
+    }
+
+    uint32_t parent(uint32_t index) const { return parents[index]; }
+    int move(uint32_t index) const { return moves[index]; } // MOVE_NONE na raiz
+
+    // Estados do caminho da raiz até o nó index
+    std::vector<PuzzleState> path(uint32_t index) const {
+        std::vector<PuzzleState> states;
+        for (uint32_t i = index; i != NO_PARENT; i = parents[i]) {
+            states.push_back(state(i));
+        }
+        std::reverse(states.begin(), states.end());
+        return states;
+    }
+
+    size_t size() const {
+        return tiles.size();
+    }
+
+    // Memória reservada pelos vetores, em bytes
+    size_t bytesUsed() const {
+        return tiles.capacity() * sizeof(uint64_t) + zeros.capacity() + parents.capacity() * sizeof(uint32_t) + moves.capacity();
+    }
+
+private:
+    std::vector<uint64_t> tiles; // Peças compactadas de cada nó
+    std::vector<uint8_t> zeros; // Posição do zero de cada nó
+    std::vector<uint32_t> parents; // Índice do pai (NO_PARENT na raiz)
+    std::vector<uint8_t> moves; // Movimento do zero que gerou o nó
+    uint8_t width = 0;
+    uint8_t cells = 0;
+};
+
+// Monta o caminho como nós ligados pelos pais, guardados em storage (do início ao fim),
+// para as buscas que devolvem a solução como vetor de ponteiros
+template <typename T>
+std::vector<T*> linkPath(const std::vector<PuzzleState>& states, std::vector<T>& storage) {
+    storage.clear();
+    storage.reserve(states.size()); // Evita realocação, que invalidaria os ponteiros dos pais
+    std::vector<T*> path;
+    path.reserve(states.size());
+    for (const PuzzleState& state : states) {
+        T* parent = storage.empty() ? nullptr : &storage.back();
+        storage.emplace_back(state, parent, static_cast<int>(storage.size()));
+        path.push_back(&storage.back());
+    }
+    return path;
+}
+
+#endif // NODESTORE_H
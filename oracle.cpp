@@ -0,0 +1,159 @@
+#include "oracle.h"
+#include "permutation.h"
+#include <cstring>
+#include <fstream>
+
+// Formato do arquivo (little-endian):
+//   "ORC1", cells (1 byte), largura (1 byte), 2 bytes reservados,
+//   estado objetivo compactado (8 bytes),
+//   e em seguida boardCount(cells) bytes, um por tabuleiro ranqueado: a distância nos
+//   6 bits altos e, nos 2 baixos, o movimento do zero que aproxima do objetivo.
+static const char ORACLE_MAGIC[4] = { 'O', 'R', 'C', '1' };
+static const size_t ORACLE_HEADER_SIZE = 16;
+
+const int DistanceOracle::MAX_CELLS;
+const uint8_t DistanceOracle::UNREACHED;
+const int DistanceOracle::MAX_DISTANCE;
+
+DistanceOracle::DistanceOracle() : table(nullptr), entries(0), goalKey(0), cells(0), width(0), parity(0) {}
+
+void DistanceOracle::build(const PuzzleState& goal) {
+    file.close();
+    goalKey = goal.key();
+    cells = goal.cells;
+    width = goal.width;
+    parity = boardParity(goal.tiles, cells, width);
+    entries = boardCount(cells);
+    owned.assign(entries, UNREACHED);
+
+    // BFS a partir do objetivo: o vizinho alcançado pelo movimento m volta ao estado
+    // expandido, um passo mais perto do objetivo, pelo movimento inverso
+    std::vector<PuzzleState> frontier(1, goal);
+    frontier.reserve(entries);
+    owned[rankBoard(goal.tiles, cells)] = 0;
+    for (size_t i = 0; i < frontier.size(); ++i) {
+        PuzzleState current = frontier[i];
+        int next = (owned[rankBoard(current.tiles, cells)] >> 2) + 1;
+        for (int m = MOVE_UP; m <= MOVE_DOWN; ++m) {
+            int newZero = current.target(m);
+            if (newZero < 0) {
+                continue;
+            }
+            PuzzleState neighbor = current.moved(newZero);
+            uint8_t& slot = owned[rankBoard(neighbor.tiles, cells)];
+            if (slot == UNREACHED) {
+                slot = static_cast<uint8_t>(next << 2 | inverseMove(m));
+                frontier.push_back(neighbor);
+            }
+        }
+    }
+    table = owned.data();
+}
+
+bool DistanceOracle::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open() || empty()) {
+        return false;
+    }
+    unsigned char header[ORACLE_HEADER_SIZE] = {};
+    std::memcpy(header, ORACLE_MAGIC, 4);
+    header[4] = static_cast<unsigned char>(cells);
+    header[5] = static_cast<unsigned char>(width);
+    std::memcpy(header + 8, &goalKey, 8);
+    out.write(reinterpret_cast<const char*>(header), ORACLE_HEADER_SIZE);
+    out.write(reinterpret_cast<const char*>(table), static_cast<std::streamsize>(entries));
+    return static_cast<bool>(out);
+}
+
+bool DistanceOracle::load(const std::string& path) {
+    table = nullptr;
+    owned.clear();
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* data = file.data();
+    // Só o 8-puzzle tem tabela densa: qualquer outro tamanho ou largura é arquivo corrompido
+    if (file.size() < ORACLE_HEADER_SIZE || std::memcmp(data, ORACLE_MAGIC, 4) != 0 || data[4] != MAX_CELLS || data[5] != 3) {
+        file.close();
+        return false;
+    }
+    cells = data[4];
+    width = data[5];
+    std::memcpy(&goalKey, data + 8, 8);
+    entries = boardCount(cells);
+    if (file.size() != ORACLE_HEADER_SIZE + entries || !validGoal()) {
+        file.close();
+        return false;
+    }
+    // A chave é o próprio tabuleiro compactado, então a paridade do objetivo sai dela
+    parity = boardParity(goalKey, cells, width);
+
+    // Toda entrada é UNREACHED ou uma distância possível, e só o objetivo tem distância 0
+    const uint8_t* values = data + ORACLE_HEADER_SIZE;
+    uint64_t goalRank = rankBoard(goalKey, cells);
+    for (uint64_t rank = 0; rank < entries; ++rank) {
+        uint8_t value = values[rank];
+        if (value != UNREACHED && ((value >> 2) > MAX_DISTANCE || ((value >> 2) == 0) != (rank == goalRank))) {
+            file.close();
+            return false;
+        }
+    }
+    table = values;
+    return true;
+}
+
+// O objetivo do cabeçalho tem as peças 0..cells-1, cada uma uma vez
+bool DistanceOracle::validGoal() const {
+    uint32_t seen = 0;
+    for (int pos = 0; pos < cells; ++pos) {
+        int tile = static_cast<int>((goalKey >> (4 * pos)) & 0xF);
+        if (tile >= cells || (seen & (1u << tile))) {
+            return false;
+        }
+        seen |= 1u << tile;
+    }
+    return (goalKey >> (4 * cells)) == 0;
+}
+
+bool DistanceOracle::matches(const PuzzleState& goal) const {
+    return !empty() && goal.key() == goalKey && goal.cells == cells;
+}
+
+uint8_t DistanceOracle::entry(const PuzzleState& state) const {
+    if (state.cells != cells || boardParity(state.tiles, cells, width) != parity) {
+        return UNREACHED;
+    }
+    return table[rankBoard(state.tiles, cells)];
+}
+
+int DistanceOracle::distance(const PuzzleState& state) const {
+    uint8_t value = entry(state);
+    return value == UNREACHED ? -1 : value >> 2;
+}
+
+std::vector<PuzzleState> DistanceOracle::solve(const PuzzleState& state) const {
+    std::vector<PuzzleState> path;
+    uint8_t value = entry(state);
+    if (value == UNREACHED) {
+        return path;
+    }
+    int steps = value >> 2;
+    path.reserve(steps + 1);
+    PuzzleState current = state;
+    path.push_back(current);
+    // Segue o movimento guardado até o objetivo. Cada passo precisa reduzir a distância
+    // em um, então a caminhada para em steps movimentos mesmo com uma tabela adulterada.
+    for (int step = steps; step > 0; --step) {
+        int newZero = current.target(value & 3);
+        if (newZero < 0) {
+            return {};
+        }
+        current = current.moved(newZero);
+        path.push_back(current);
+        value = table[rankBoard(current.tiles, cells)];
+        if (value == UNREACHED || (value >> 2) != step - 1) {
+            return {};
+        }
+    }
+    return path;
+}
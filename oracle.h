@@ -0,0 +1,52 @@
+#ifndef ORACLE_H
+#define ORACLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "puzzlestate.h"
+#include "mappedfile.h"
+
+// Oráculo de distâncias do 8-puzzle: uma BFS retrógrada a partir do objetivo grava,
+// para cada tabuleiro ranqueado (ver rankBoard), a distância ótima até o objetivo e o
+// movimento que a reduz, num byte só. A tabela inteira tem 9!/2 = 181.440 bytes e é
+// carregada com mmap; um caminho ótimo sai em O(tamanho do caminho), sem busca.
+class DistanceOracle {
+public:
+    static const int MAX_CELLS = 9; // Maior tabuleiro com tabela densa
+    static const uint8_t UNREACHED = 0xFF;
+    static const int MAX_DISTANCE = 31; // Diâmetro do 8-puzzle: nenhuma entrada válida passa disso
+
+    DistanceOracle();
+
+    // Constrói a tabela em memória para o objetivo dado
+    void build(const PuzzleState& goal);
+
+    bool save(const std::string& path) const; // Grava a tabela no formato compacto
+    bool load(const std::string& path); // Mapeia um arquivo gerado por save(); false se estiver corrompido
+
+    bool empty() const { return table == nullptr; }
+    bool matches(const PuzzleState& goal) const; // Se a tabela vale para este objetivo
+    size_t bytes() const { return static_cast<size_t>(entries); }
+
+    // Distância ótima até o objetivo, ou -1 se o estado não o alcança
+    int distance(const PuzzleState& state) const;
+
+    // Caminho ótimo do estado ao objetivo (vazio se não houver solução)
+    std::vector<PuzzleState> solve(const PuzzleState& state) const;
+
+private:
+    const uint8_t* table; // distância << 2 | movimento, no arquivo mapeado ou em owned
+    std::vector<uint8_t> owned; // Tabela construída em memória
+    uint64_t entries;
+    uint64_t goalKey; // Estado objetivo usado na construção
+    int cells;
+    int width;
+    int parity; // Paridade do objetivo (ver boardParity)
+    MappedFile file;
+
+    uint8_t entry(const PuzzleState& state) const; // UNREACHED se for de outra paridade
+    bool validGoal() const; // Se goalKey é uma permutação das peças de cells posições
+};
+
+#endif // ORACLE_H
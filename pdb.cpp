@@ -0,0 +1,314 @@
+#include "pdb.h"
+#include "permutation.h"
+#include "puzzledomain.h"
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// Formato do arquivo (little-endian):
+//   "PDB1", cells (1 byte), número de padrões (1 byte), 2 bytes reservados,
+//   estado objetivo compactado (8 bytes),
+//   para cada padrão: tamanho (1 byte), peças (15 bytes), offset (8 bytes), entradas (8 bytes),
+//   e em seguida as tabelas, um byte por arranjo.
+static const char PDB_MAGIC[4] = { 'P', 'D', 'B', '1' };
+static const size_t PDB_HEADER_SIZE = 16;
+static const size_t PDB_PATTERN_SIZE = 32;
+
+int PatternDatabase::lookup(const int* where) const {
+    int positions[15];
+    for (int i = 0; i < size; ++i) {
+        positions[i] = where[tiles[i]];
+    }
+    return table[rankPartial(positions, size, cells)];
+}
+
+// Reduz a distância guardada em slot para value, se ela for maior; retorna true se
+// esta thread fez a redução (e portanto deve expandir o estado)
+static bool lowerDistance(std::atomic<uint8_t>& slot, int value) {
+    uint8_t current = slot.load(std::memory_order_relaxed);
+    while (current > value) {
+        if (slot.compare_exchange_weak(current, static_cast<uint8_t>(value), std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Executa body(thread, início, fim) sobre [0, count) em blocos distribuídos dinamicamente
+template <typename Body>
+static void parallelFor(size_t count, int threads, Body body) {
+    const size_t chunk = 4096;
+    if (threads <= 1 || count <= chunk) {
+        body(0, 0, count);
+        return;
+    }
+    std::atomic<size_t> cursor(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (true) {
+                size_t begin = cursor.fetch_add(chunk);
+                if (begin >= count) {
+                    break;
+                }
+                body(t, begin, std::min(count, begin + chunk));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::vector<uint8_t> buildPatternTable(const PuzzleState& goal, const std::vector<int>& tiles, int threads) {
+    const int n = goal.cells;
+    const int k = static_cast<int>(tiles.size());
+    const MoveTable& board = moveTableFor(goal.width);
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // Estado abstrato: posições das k peças do padrão seguidas da posição do zero
+    const uint64_t total = partialCount(n, k + 1);
+    std::unique_ptr<std::atomic<uint8_t>[]> distance(new std::atomic<uint8_t>[total]);
+    parallelFor(total, threads, [&](int, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            distance[i].store(0xFF, std::memory_order_relaxed);
+        }
+    });
+
+    int positions[16];
+    for (int i = 0; i < k; ++i) {
+        positions[i] = goal.find(tiles[i]);
+    }
+    positions[k] = goal.zero;
+    uint32_t start = static_cast<uint32_t>(rankPartial(positions, k + 1, n));
+    distance[start].store(0, std::memory_order_relaxed);
+
+    // BFS 0-1 por camadas: mover o zero para uma posição fora do padrão não custa nada
+    // e mantém o estado na camada atual; trocar o zero com uma peça do padrão custa 1.
+    // Cada camada é processada em rodadas até esgotar as descobertas de custo zero, e
+    // cada thread acumula suas descobertas em listas próprias.
+    std::vector<std::vector<uint32_t>> sameLayer(threads);
+    std::vector<std::vector<uint32_t>> nextLayer(threads);
+    std::vector<uint32_t> frontier(1, start);
+    std::vector<uint32_t> upcoming;
+    for (int d = 0; !frontier.empty(); ++d) {
+        while (!frontier.empty()) {
+            parallelFor(frontier.size(), threads, [&](int t, size_t begin, size_t end) {
+                int state[16];
+                for (size_t i = begin; i < end; ++i) {
+                    uint32_t index = frontier[i];
+                    if (distance[index].load(std::memory_order_relaxed) != d) {
+                        continue; // Já foi alcançado com custo menor
+                    }
+                    unrankPartial(index, k + 1, n, state);
+                    int blank = state[k];
+                    for (int m = 0; m < 4; ++m) {
+                        int target = board.target[blank][m];
+                        if (target < 0) {
+                            continue;
+                        }
+                        int owner = -1; // Peça do padrão na posição de destino, se houver
+                        for (int j = 0; j < k; ++j) {
+                            if (state[j] == target) {
+                                owner = j;
+                                break;
+                            }
+                        }
+                        if (owner >= 0) {
+                            state[owner] = blank;
+                        }
+                        state[k] = target;
+                        uint32_t neighbor = static_cast<uint32_t>(rankPartial(state, k + 1, n));
+                        if (owner < 0) {
+                            if (lowerDistance(distance[neighbor], d)) {
+                                sameLayer[t].push_back(neighbor);
+                            }
+                        } else if (lowerDistance(distance[neighbor], d + 1)) {
+                            nextLayer[t].push_back(neighbor);
+                        }
+                        if (owner >= 0) {
+                            state[owner] = target;
+                        }
+                        state[k] = blank;
+                    }
+                }
+            });
+            // Junta as listas das threads: as de custo zero formam a próxima rodada
+            frontier.clear();
+            for (int t = 0; t < threads; ++t) {
+                frontier.insert(frontier.end(), sameLayer[t].begin(), sameLayer[t].end());
+                sameLayer[t].clear();
+                upcoming.insert(upcoming.end(), nextLayer[t].begin(), nextLayer[t].end());
+                nextLayer[t].clear();
+            }
+        }
+        frontier.swap(upcoming);
+    }
+
+    // A posição do zero é o último dígito do índice, então cada arranjo das peças
+    // ocupa um bloco contíguo de n - k entradas; o padrão guarda o mínimo do bloco
+    const uint64_t entries = partialCount(n, k);
+    std::vector<uint8_t> table(entries);
+    parallelFor(entries, threads, [&](int, size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            uint8_t best = 0xFF;
+            for (int b = 0; b < n - k; ++b) {
+                uint8_t value = distance[r * (n - k) + b].load(std::memory_order_relaxed);
+                if (value < best) {
+                    best = value;
+                }
+            }
+            table[r] = best;
+        }
+    });
+    return table;
+}
+
+AdditivePDB::AdditivePDB() : goalKey(0), cells(0) {}
+
+std::vector<std::vector<int>> AdditivePDB::defaultPartition15() {
+    return {
+        { 1, 4, 5, 8, 9, 12 },
+        { 2, 3, 6, 7, 10, 11 },
+        { 13, 14, 15 }
+    };
+}
+
+void AdditivePDB::build(const PuzzleState& goal, const std::vector<std::vector<int>>& partition, int threads, std::ostream* progress) {
+    file.close();
+    patterns.clear();
+    goalKey = goal.key();
+    cells = goal.cells;
+    for (const std::vector<int>& tiles : partition) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PatternDatabase pattern;
+        pattern.size = static_cast<int>(tiles.size());
+        for (int i = 0; i < pattern.size; ++i) {
+            pattern.tiles[i] = tiles[i];
+        }
+        pattern.cells = cells;
+        pattern.owned = buildPatternTable(goal, tiles, threads);
+        pattern.entries = pattern.owned.size();
+        patterns.push_back(std::move(pattern));
+
+        if (progress) { // Relata o tempo e a vazão (estados abstratos por segundo) do padrão
+            auto end_time = std::chrono::high_resolution_clock::now();
+            double seconds = std::chrono::duration<double>(end_time - start_time).count();
+            uint64_t states = partialCount(cells, static_cast<int>(tiles.size()) + 1);
+            *progress << "PDB padrão " << patterns.size() << "/" << partition.size() << " ("
+                      << tiles.size() << " peças): " << states << " estados, " << seconds << " s, "
+                      << (seconds > 0 ? states / seconds / 1e6 : 0) << " M estados/s, "
+                      << threads << " threads" << std::endl;
+        }
+    }
+    // Aponta as tabelas só depois de preencher o vetor, que pode ter sido realocado
+    for (PatternDatabase& pattern : patterns) {
+        pattern.table = pattern.owned.data();
+    }
+}
+
+bool AdditivePDB::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    unsigned char header[PDB_HEADER_SIZE] = {};
+    std::memcpy(header, PDB_MAGIC, 4);
+    header[4] = static_cast<unsigned char>(cells);
+    header[5] = static_cast<unsigned char>(patterns.size());
+    std::memcpy(header + 8, &goalKey, 8);
+    out.write(reinterpret_cast<const char*>(header), PDB_HEADER_SIZE);
+
+    uint64_t offset = PDB_HEADER_SIZE + PDB_PATTERN_SIZE * patterns.size();
+    for (const PatternDatabase& pattern : patterns) {
+        unsigned char entry[PDB_PATTERN_SIZE] = {};
+        entry[0] = static_cast<unsigned char>(pattern.size);
+        for (int i = 0; i < pattern.size; ++i) {
+            entry[1 + i] = static_cast<unsigned char>(pattern.tiles[i]);
+        }
+        std::memcpy(entry + 16, &offset, 8);
+        std::memcpy(entry + 24, &pattern.entries, 8);
+        out.write(reinterpret_cast<const char*>(entry), PDB_PATTERN_SIZE);
+        offset += pattern.entries;
+    }
+    for (const PatternDatabase& pattern : patterns) {
+        out.write(reinterpret_cast<const char*>(pattern.table), static_cast<std::streamsize>(pattern.entries));
+    }
+    return static_cast<bool>(out);
+}
+
+bool AdditivePDB::load(const std::string& path) {
+    patterns.clear();
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* data = file.data();
+    if (file.size() < PDB_HEADER_SIZE || std::memcmp(data, PDB_MAGIC, 4) != 0) {
+        file.close();
+        return false;
+    }
+    cells = data[4];
+    int count = data[5];
+    std::memcpy(&goalKey, data + 8, 8);
+    if (cells < 4 || cells > 16 || file.size() < PDB_HEADER_SIZE + PDB_PATTERN_SIZE * count) {
+        file.close();
+        return false;
+    }
+    uint32_t used = 0; // Peças já vistas: os padrões são disjuntos e nunca incluem o zero
+    for (int p = 0; p < count; ++p) {
+        const unsigned char* entry = data + PDB_HEADER_SIZE + PDB_PATTERN_SIZE * p;
+        PatternDatabase pattern;
+        pattern.size = entry[0];
+        bool tilesValid = pattern.size <= 15;
+        for (int i = 0; tilesValid && i < pattern.size; ++i) {
+            int tile = entry[1 + i];
+            // A peça indexa where[] em lookup: precisa existir no tabuleiro
+            tilesValid = tile >= 1 && tile < cells && !(used & (1u << tile));
+            used |= 1u << tile;
+            pattern.tiles[i] = tile;
+        }
+        pattern.cells = cells;
+        uint64_t offset;
+        std::memcpy(&offset, entry + 16, 8);
+        std::memcpy(&pattern.entries, entry + 24, 8);
+        if (!tilesValid || pattern.entries != partialCount(cells, pattern.size) || offset > file.size() || pattern.entries > file.size() - offset) {
+            patterns.clear();
+            file.close();
+            return false;
+        }
+        pattern.table = data + offset;
+        patterns.push_back(pattern);
+    }
+    return true;
+}
+
+bool AdditivePDB::matches(const PuzzleState& goal) const {
+    return !patterns.empty() && goal.key() == goalKey && goal.cells == cells;
+}
+
+size_t AdditivePDB::bytes() const {
+    size_t total = 0;
+    for (const PatternDatabase& pattern : patterns) {
+        total += pattern.entries;
+    }
+    return total;
+}
+
+int AdditivePDB::evaluate(const PuzzleState& state) const {
+    int where[16]; // Posição de cada peça
+    for (int i = 0; i < state.cells; ++i) {
+        where[state.at(i)] = i;
+    }
+    int distance = 0;
+    for (const PatternDatabase& pattern : patterns) {
+        distance += pattern.lookup(where);
+    }
+    return distance;
+}
@@ -0,0 +1,62 @@
+#ifndef PDB_H
+#define PDB_H
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include <vector>
+#include "puzzlestate.h"
+#include "mappedfile.h"
+
+// Banco de padrões de um subconjunto de peças: para cada arranjo das peças do padrão,
+// o menor número de movimentos dessas peças até o objetivo (o zero anda livremente
+// pelas demais posições sem custo). Padrões disjuntos podem ser somados.
+class PatternDatabase {
+public:
+    int size; // Número de peças do padrão
+    int tiles[15]; // Peças do padrão
+    int cells; // Posições do tabuleiro
+    uint64_t entries; // Número de arranjos (cells! / (cells - size)!)
+    const uint8_t* table; // Distâncias, no arquivo mapeado ou em owned
+    std::vector<uint8_t> owned; // Tabela construída em memória
+
+    PatternDatabase() : size(0), cells(0), entries(0), table(nullptr) {}
+
+    // Distância do arranjo dado pela posição de cada peça (where[peça] = posição)
+    int lookup(const int* where) const;
+};
+
+// Heurística aditiva com padrões disjuntos, construída por uma BFS retrógrada a partir
+// do objetivo e gravada em um arquivo que é carregado com mmap.
+class AdditivePDB {
+public:
+    AdditivePDB();
+
+    // Partição 6-6-3 do 15-puzzle (objetivo com o zero no canto superior esquerdo)
+    static std::vector<std::vector<int>> defaultPartition15();
+
+    // Constrói as tabelas de todos os padrões da partição para o objetivo dado, com
+    // threads linhas de execução; se progress não for nulo, relata o tempo de cada padrão
+    void build(const PuzzleState& goal, const std::vector<std::vector<int>>& partition, int threads = 1, std::ostream* progress = nullptr);
+
+    bool save(const std::string& path) const; // Grava as tabelas no formato compacto
+    bool load(const std::string& path); // Mapeia um arquivo gerado por save()
+
+    bool empty() const { return patterns.empty(); }
+    bool matches(const PuzzleState& goal) const; // Se as tabelas valem para este objetivo
+    size_t bytes() const; // Memória das tabelas
+
+    // Soma das distâncias de todos os padrões
+    int evaluate(const PuzzleState& state) const;
+
+private:
+    std::vector<PatternDatabase> patterns;
+    uint64_t goalKey; // Estado objetivo usado na construção
+    int cells;
+    MappedFile file;
+};
+
+// Constrói a tabela de um único padrão (BFS 0-1 em paralelo sobre as peças do padrão e o zero)
+std::vector<uint8_t> buildPatternTable(const PuzzleState& goal, const std::vector<int>& tiles, int threads = 1);
+
+#endif // PDB_H
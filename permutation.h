@@ -0,0 +1,151 @@
+#ifndef PERMUTATION_H
+#define PERMUTATION_H
+
+#include <cstdint>
+
+// Ranqueamento de permutações parciais: m posições distintas escolhidas entre n
+// viram um índice denso em [0, n!/(n-m)!), na base mista n, n-1, ..., n-m+1 (código
+// de Lehmer truncado, em tempo linear com popcount). Usado para indexar as tabelas dos
+// bancos de padrões e, com m = n, para ranquear tabuleiros inteiros.
+
+// Número de arranjos de m posições entre n
+inline uint64_t partialCount(int n, int m) {
+    uint64_t count = 1;
+    for (int i = 0; i < m; ++i) {
+        count *= static_cast<uint64_t>(n - i);
+    }
+    return count;
+}
+
+// Índice das posições positions[0..m-1] (distintas, em [0, n))
+inline uint64_t rankPartial(const int* positions, int m, int n) {
+    uint64_t rank = 0;
+    uint32_t used = 0;
+    for (int i = 0; i < m; ++i) {
+        int pos = positions[i];
+        // Posição ajustada: quantas posições livres existem antes de pos
+        int adjusted = pos - __builtin_popcount(used & ((1u << pos) - 1));
+        rank = rank * static_cast<uint64_t>(n - i) + static_cast<uint64_t>(adjusted);
+        used |= 1u << pos;
+    }
+    return rank;
+}
+
+// Operação inversa de rankPartial
+inline void unrankPartial(uint64_t rank, int m, int n, int* positions) {
+    int digits[16];
+    for (int i = m - 1; i >= 0; --i) {
+        digits[i] = static_cast<int>(rank % static_cast<uint64_t>(n - i));
+        rank /= static_cast<uint64_t>(n - i);
+    }
+    uint32_t used = 0;
+    for (int i = 0; i < m; ++i) {
+        // Procura a digits[i]-ésima posição ainda livre
+        int free = digits[i];
+        int pos = 0;
+        while (true) {
+            if (!(used & (1u << pos))) {
+                if (free == 0) {
+                    break;
+                }
+                free--;
+            }
+            pos++;
+        }
+        positions[i] = pos;
+        used |= 1u << pos;
+    }
+}
+
+// Paridade invariante de um tabuleiro compactado (4 bits por posição): a paridade das
+// inversões entre as peças, somada à linha do zero quando a largura é par. Um movimento
+// nunca a altera, então ela separa as duas metades de cells! estados que não se alcançam.
+inline int boardParity(uint64_t tiles, int cells, int width) {
+    int sequence[16];
+    int count = 0;
+    int zero = 0;
+    for (int pos = 0; pos < cells; ++pos) {
+        int tile = static_cast<int>((tiles >> (4 * pos)) & 0xF);
+        if (tile == 0) {
+            zero = pos;
+        } else {
+            sequence[count++] = tile;
+        }
+    }
+    int inversions = 0;
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            inversions += sequence[i] > sequence[j];
+        }
+    }
+    if (width % 2 == 0) {
+        inversions += zero / width;
+    }
+    return inversions & 1;
+}
+
+// Número de tabuleiros de mesma paridade: cells! / 2
+inline uint64_t boardCount(int cells) {
+    return partialCount(cells, cells) / 2;
+}
+
+// Posto do tabuleiro entre os cells!/2 de mesma paridade, em [0, boardCount(cells)):
+// a posição do zero vezes o posto das peças restantes. Das cells - 1 peças só as
+// cells - 3 primeiras entram no posto, já que as duas últimas ficam determinadas pela
+// paridade (o tabuleiro precisa de pelo menos 3 posições).
+inline uint64_t rankBoard(uint64_t tiles, int cells) {
+    int sequence[16];
+    int count = 0;
+    int zero = 0;
+    for (int pos = 0; pos < cells; ++pos) {
+        int tile = static_cast<int>((tiles >> (4 * pos)) & 0xF);
+        if (tile == 0) {
+            zero = pos;
+        } else {
+            sequence[count++] = tile - 1; // Peças 1..cells-1 viram 0..cells-2
+        }
+    }
+    uint64_t tilesRank = rankPartial(sequence, cells - 3, cells - 1);
+    return static_cast<uint64_t>(zero) * partialCount(cells - 1, cells - 3) + tilesRank;
+}
+
+// Operação inversa de rankBoard para tabuleiros com a paridade dada (ver boardParity)
+inline uint64_t unrankBoard(uint64_t rank, int cells, int width, int parity) {
+    uint64_t tilesCount = partialCount(cells - 1, cells - 3);
+    int zero = static_cast<int>(rank / tilesCount);
+    int sequence[16];
+    unrankPartial(rank % tilesCount, cells - 3, cells - 1, sequence);
+
+    // As duas peças que faltam, na ordem crescente
+    uint32_t used = 0;
+    for (int i = 0; i < cells - 3; ++i) {
+        used |= 1u << sequence[i];
+    }
+    int last = 0;
+    for (int tile = 0; tile < cells - 1; ++tile) {
+        if (!(used & (1u << tile))) {
+            sequence[cells - 3 + last++] = tile;
+        }
+    }
+
+    // Monta o tabuleiro; se a paridade não bater, troca as duas últimas peças
+    uint64_t tiles = 0;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        tiles = 0;
+        int next = 0;
+        for (int pos = 0; pos < cells; ++pos) {
+            if (pos != zero) {
+                tiles |= static_cast<uint64_t>(sequence[next++] + 1) << (4 * pos);
+            }
+        }
+        if (boardParity(tiles, cells, width) == parity) {
+            break;
+        }
+        int swap = sequence[cells - 3];
+        sequence[cells - 3] = sequence[cells - 2];
+        sequence[cells - 2] = swap;
+    }
+    return tiles;
+}
+
+#endif // PERMUTATION_H
@@ -0,0 +1,78 @@
+#ifndef PUZZLEDOMAIN_H
+#define PUZZLEDOMAIN_H
+
+#include <cstdint>
+
+// Movimentos do zero, na ordem em que todas as buscas geram os filhos
+enum Move {
+    MOVE_UP = 0,
+    MOVE_LEFT = 1,
+    MOVE_RIGHT = 2,
+    MOVE_DOWN = 3,
+    MOVE_NONE = 4
+};
+
+// Movimento que desfaz m (cima <-> baixo, esquerda <-> direita)
+constexpr int inverseMove(int m) {
+    return MOVE_DOWN - m;
+}
+
+// Tabelas de um tabuleiro: para cada posição do zero, o destino de cada movimento
+// (-1 quando o movimento sai do tabuleiro), além da linha e coluna de cada posição.
+struct MoveTable {
+    int8_t target[16][4];
+    int8_t row[16];
+    int8_t col[16];
+};
+
+constexpr MoveTable makeMoveTable(int width, int height) {
+    MoveTable table{};
+    for (int pos = 0; pos < width * height; ++pos) {
+        int row = pos / width;
+        int col = pos % width;
+        table.row[pos] = static_cast<int8_t>(row);
+        table.col[pos] = static_cast<int8_t>(col);
+        table.target[pos][MOVE_UP] = static_cast<int8_t>(row > 0 ? pos - width : -1);
+        table.target[pos][MOVE_LEFT] = static_cast<int8_t>(col > 0 ? pos - 1 : -1);
+        table.target[pos][MOVE_RIGHT] = static_cast<int8_t>(col < width - 1 ? pos + 1 : -1);
+        table.target[pos][MOVE_DOWN] = static_cast<int8_t>(row < height - 1 ? pos + width : -1);
+    }
+    return table;
+}
+
+// Domínio do quebra-cabeça W x H com as tabelas calculadas em tempo de compilação.
+// O estado compactado usa 4 bits por posição em um uint64_t, o que limita o tabuleiro
+// a 16 posições (8-puzzle e 15-puzzle). Os laços das buscas (A*, GBFS, IDA*) são
+// instanciados por domínio, de modo que a tabela de movimentos é uma constante.
+template <int W, int H>
+struct PuzzleDomain {
+    static_assert(W * H <= 16, "o estado compactado comporta no máximo 16 posições");
+
+    static constexpr int width = W;
+    static constexpr MoveTable moves = makeMoveTable(W, H);
+
+    // Tabela de movimentos; a largura do estado é ignorada, pois é sempre W
+    static const MoveTable& table(int) {
+        return moves;
+    }
+};
+
+template <int W, int H>
+constexpr MoveTable PuzzleDomain<W, H>::moves;
+
+typedef PuzzleDomain<3, 3> Domain8; // 8-puzzle
+typedef PuzzleDomain<4, 4> Domain15; // 15-puzzle
+
+// Tabela do tabuleiro quadrado de largura width (3 ou 4)
+inline const MoveTable& moveTableFor(int width) {
+    return width == 4 ? Domain15::moves : Domain8::moves;
+}
+
+// Domínio escolhido em tempo de execução pela largura, para o código não especializado
+struct RuntimeDomain {
+    static const MoveTable& table(int width) {
+        return moveTableFor(width);
+    }
+};
+
+#endif // PUZZLEDOMAIN_H
@@ -0,0 +1,126 @@
+#ifndef PUZZLESTATE_H
+#define PUZZLESTATE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <iostream>
+#include "puzzledomain.h"
+
+// Estado compactado do quebra-cabeça: cada posição ocupa 4 bits de um único uint64_t,
+// o que comporta até 16 posições (8-puzzle e 15-puzzle). A posição do zero fica
+// guardada à parte para que os movimentos não precisem procurá-lo.
+class PuzzleState {
+public:
+    uint64_t tiles; // Peças compactadas, a posição i ocupa os bits [4*i, 4*i + 4)
+    uint8_t zero; // Posição do espaço vazio
+    uint8_t width; // Largura do tabuleiro (3 para o 8-puzzle, 4 para o 15-puzzle)
+    uint8_t cells; // Número de posições do tabuleiro
+
+    PuzzleState() : tiles(0), zero(0), width(0), cells(0) {}
+
+    // Converte um vetor de peças (linha a linha) para a forma compactada
+    explicit PuzzleState(const std::vector<int>& values) : tiles(0), zero(0), width(0), cells(0) {
+        cells = static_cast<uint8_t>(values.size());
+        while ((width + 1) * (width + 1) <= cells) {
+            width++;
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+            tiles |= static_cast<uint64_t>(values[i] & 0xF) << (4 * i);
+            if (values[i] == 0) {
+                zero = static_cast<uint8_t>(i);
+            }
+        }
+    }
+
+    // Retorna a peça na posição pos
+    int at(int pos) const {
+        return static_cast<int>((tiles >> (4 * pos)) & 0xF);
+    }
+
+    // Retorna a posição da peça tile (busca linear, usada fora do laço principal)
+    int find(int tile) const {
+        for (int i = 0; i < cells; ++i) {
+            if (at(i) == tile) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int findZero() const {
+        return zero;
+    }
+
+    // Destino do zero para o movimento m (ver Move), ou -1 se ele sai do tabuleiro
+    int target(int m) const {
+        return moveTableFor(width).target[zero][m];
+    }
+
+    bool canMoveUp() const { return target(MOVE_UP) >= 0; }
+    bool canMoveDown() const { return target(MOVE_DOWN) >= 0; }
+    bool canMoveLeft() const { return target(MOVE_LEFT) >= 0; }
+    bool canMoveRight() const { return target(MOVE_RIGHT) >= 0; }
+
+    // Move o zero para newZero trocando-o com a peça que estava lá, em O(1)
+    PuzzleState moved(int newZero) const {
+        PuzzleState next = *this;
+        uint64_t tile = (tiles >> (4 * newZero)) & 0xF;
+        next.tiles &= ~(static_cast<uint64_t>(0xF) << (4 * newZero));
+        next.tiles |= tile << (4 * zero);
+        next.zero = static_cast<uint8_t>(newZero);
+        return next;
+    }
+
+    PuzzleState moveUp() const { return moved(target(MOVE_UP)); }
+    PuzzleState moveDown() const { return moved(target(MOVE_DOWN)); }
+    PuzzleState moveLeft() const { return moved(target(MOVE_LEFT)); }
+    PuzzleState moveRight() const { return moved(target(MOVE_RIGHT)); }
+
+    // Chave inteira do estado (a posição do zero é deduzida das peças)
+    uint64_t key() const {
+        return tiles;
+    }
+
+    std::vector<int> toVector() const {
+        std::vector<int> values(cells);
+        for (int i = 0; i < cells; ++i) {
+            values[i] = at(i);
+        }
+        return values;
+    }
+
+    void printPuzzle() const {
+        for (int i = 0; i < cells; ++i) {
+            if (i % width == 0) {
+                std::cout << "\n";
+            }
+            std::cout << at(i) << ' ';
+        }
+    }
+
+    bool operator==(const PuzzleState& other) const {
+        return tiles == other.tiles && cells == other.cells;
+    }
+
+    bool operator!=(const PuzzleState& other) const {
+        return !(*this == other);
+    }
+};
+
+// Espalha os bits da chave compactada (finalizador do MurmurHash3)
+inline uint64_t mixKey(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Hash para usar PuzzleState em contêineres não ordenados
+struct PuzzleStateHash {
+    size_t operator()(const PuzzleState& s) const {
+        return static_cast<size_t>(mixKey(s.tiles));
+    }
+};
+
+#endif // PUZZLESTATE_H
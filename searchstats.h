@@ -0,0 +1,84 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Contadores de uma iteração do aprofundamento (um limite de f no IDA*, uma profundidade no IDFS)
+struct IterationStats {
+    int bound; // Limite da iteração
+    uint64_t expanded;
+    uint64_t generated;
+};
+
+// Estatísticas comuns a todos os algoritmos, zeradas no início de cada busca. As mesmas
+// definições valem para todos, para que os números sejam comparáveis entre eles:
+// - expanded: nós cujos filhos foram gerados (o objetivo não conta); no IDA*, todo nó
+//   visitado, inclusive os cortados pelo limite, como na contagem original, mas não os
+//   cortados pela tabela de transposição (contados em duplicates)
+// - generated: filhos criados e guardados para expansão (ou visitados, nas buscas em
+//   profundidade)
+// - duplicates: filhos ou nós descartados por já terem sido vistos (conjunto fechado,
+//   visitados da BFS, cortes da tabela de transposição, poda de movimentos)
+// - reopened: estados já expandidos que voltaram à lista aberta com custo menor (HDA*, e
+//   o A* do 15-puzzle com o banco de padrões, que não é consistente)
+// - peakOpen: maior tamanho da lista aberta; nas buscas em profundidade, o caminho mais fundo
+// - peakClosed: maior tamanho do conjunto fechado ou de visitados
+// - peakBytes: estimativa da memória das estruturas da busca no pico (nós, conjunto
+//   fechado, lista aberta, tabela de transposição)
+struct SearchStats {
+    uint64_t expanded;
+    uint64_t generated;
+    uint64_t duplicates;
+    uint64_t reopened;
+    uint64_t peakOpen;
+    uint64_t peakClosed;
+    uint64_t peakBytes;
+    double seconds; // Preenchido por quem mede a busca
+    std::vector<IterationStats> iterations; // Só no IDA* e no IDFS
+
+    SearchStats() { reset(); }
+
+    void reset() {
+        expanded = generated = duplicates = reopened = 0;
+        peakOpen = peakClosed = peakBytes = 0;
+        seconds = 0;
+        iterations.clear();
+    }
+
+    void noteOpen(size_t size) {
+        if (size > peakOpen) {
+            peakOpen = size;
+        }
+    }
+
+    void noteClosed(size_t size) {
+        if (size > peakClosed) {
+            peakClosed = size;
+        }
+    }
+
+    void noteBytes(size_t bytes) {
+        if (bytes > peakBytes) {
+            peakBytes = bytes;
+        }
+    }
+
+    // Começa uma iteração do aprofundamento; os contadores dela são preenchidos por endIteration
+    void beginIteration(int bound) {
+        iterations.push_back({ bound, expanded, generated });
+    }
+
+    void endIteration() {
+        IterationStats& last = iterations.back();
+        last.expanded = expanded - last.expanded;
+        last.generated = generated - last.generated;
+    }
+
+    double nodesPerSecond() const {
+        return seconds > 0 ? expanded / seconds : 0.0;
+    }
+};
+
+#endif // SEARCHSTATS_H
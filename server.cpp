@@ -0,0 +1,339 @@
+#include "server.h"
+#include "instancereader.h"
+#include "oracle.h"
+#include "pdb.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static const char MOVE_LETTERS[4] = { 'U', 'L', 'R', 'D' };
+
+// Lê linhas de um descritor em blocos
+class LineReader {
+public:
+    explicit LineReader(int _fd) : fd(_fd), buffer(1 << 16), start(0), end(0) {}
+
+    bool next(std::string& line) {
+        while (true) {
+            const char* newline = static_cast<const char*>(std::memchr(buffer.data() + start, '\n', end - start));
+            if (newline) {
+                size_t length = static_cast<size_t>(newline - (buffer.data() + start));
+                line.assign(buffer.data() + start, length);
+                start += length + 1;
+                return true;
+            }
+            if (start > 0) { // Move a linha incompleta para o início
+                std::memmove(buffer.data(), buffer.data() + start, end - start);
+                end -= start;
+                start = 0;
+            }
+            if (end == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            long count = static_cast<long>(::read(fd, buffer.data() + end, static_cast<unsigned>(buffer.size() - end)));
+            if (count <= 0) {
+                if (end == start) {
+                    return false;
+                }
+                line.assign(buffer.data() + start, end - start); // Última linha, sem quebra no fim
+                start = end;
+                return true;
+            }
+            end += static_cast<size_t>(count);
+        }
+    }
+
+private:
+    int fd;
+    std::vector<char> buffer;
+    size_t start;
+    size_t end;
+};
+
+static bool writeAll(int fd, const std::string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        long count = static_cast<long>(::write(fd, data.data() + done, static_cast<unsigned>(data.size() - done)));
+        if (count <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Uma conexão: as respostas são escritas por várias threads, uma linha inteira por vez.
+// O descritor é fechado quando o último pedido pendente e a leitura terminam.
+struct SolverServer::Connection {
+    int inFd;
+    int outFd;
+    bool ownsFd; // Socket: fechado no destrutor
+    std::mutex writeMutex;
+    std::mutex pendingMutex;
+    std::condition_variable finished;
+    size_t pending; // Pedidos na fila ou em execução
+
+    Connection(int _inFd, int _outFd, bool _ownsFd) : inFd(_inFd), outFd(_outFd), ownsFd(_ownsFd), pending(0) {}
+
+    ~Connection() {
+        if (ownsFd) {
+            ::close(inFd);
+        }
+    }
+
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        writeAll(outFd, line); // Se o cliente desconectou, a resposta é descartada
+    }
+
+    void addPending() {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending++;
+    }
+
+    void donePending() {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending--;
+        finished.notify_all();
+    }
+
+    void waitPending() {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        finished.wait(lock, [&]() { return pending == 0; });
+    }
+};
+
+SolverServer::SolverServer(const SolverOptions& _options, int threads)
+    : options(_options), queue(4 * static_cast<size_t>(std::max(1, threads))), served(0) {
+    for (int t = 0; t < std::max(1, threads); ++t) {
+        workers.emplace_back(&SolverServer::work, this);
+    }
+}
+
+SolverServer::~SolverServer() {
+    queue.close();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void SolverServer::work() {
+    Request request;
+    while (queue.pop(request)) {
+        SolveResult result = request.pool->solve(request.state);
+        std::ostringstream line;
+        line << request.id << " ok " << result.record.nodes << " " << result.record.length << " "
+             << result.record.seconds << " " << result.heuristicAverage << " " << result.startHeuristic << " ";
+        if (result.record.flags & ResultRecord::HAS_MOVES) {
+            for (uint8_t move : result.record.moves) {
+                line << MOVE_LETTERS[move];
+            }
+        }
+        if (!(result.record.flags & ResultRecord::HAS_MOVES) || result.record.moves.empty()) {
+            line << '-';
+        }
+        line << '\n';
+        request.connection->send(line.str());
+        served++;
+        request.connection->donePending();
+        request.connection.reset(); // Solta a conexão antes de esperar o próximo pedido
+    }
+}
+
+SolverPool* SolverServer::poolFor(const SolverInfo& info, int cells) {
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    std::unique_ptr<SolverPool>& pool = pools[std::make_pair(std::string(info.flag), cells)];
+    if (!pool) {
+        SolverOptions sized = options;
+        if (cells != 16) { // O banco de padrões só cobre o 15-puzzle
+            sized.pdb = nullptr;
+            if (sized.heuristic == HEURISTIC_PDB) {
+                sized.heuristic = HEURISTIC_MANHATTAN;
+            }
+        }
+        std::vector<int> goal(static_cast<size_t>(cells));
+        for (int i = 0; i < cells; ++i) {
+            goal[static_cast<size_t>(i)] = i;
+        }
+        pool.reset(new SolverPool(info, PuzzleState(goal), sized));
+    }
+    return pool.get();
+}
+
+void SolverServer::handleLine(const std::shared_ptr<Connection>& connection, const std::string& line) {
+    std::istringstream words(line);
+    std::string id;
+    std::string flag;
+    if (!(words >> id)) {
+        return; // Linha vazia
+    }
+    const SolverInfo* info = (words >> flag) ? findSolver(flag) : nullptr;
+    if (!info) {
+        connection->send(id + " erro algoritmo não reconhecido\n");
+        return;
+    }
+    std::streamoff offset = words.tellg();
+    PuzzleState state;
+    if (offset < 0 || !InstanceReader::parse(line.data() + offset, line.data() + line.size(), 0, state)) {
+        connection->send(id + " erro tabuleiro inválido\n");
+        return;
+    }
+    if (flag == "-astar15" && state.cells != 16) {
+        connection->send(id + " erro -astar15 só resolve o 15-puzzle\n");
+        return;
+    }
+    if (flag == "-oracle" && (state.cells != 9 || !options.oracle || options.oracle->empty())) {
+        connection->send(id + " erro o oráculo só cobre o 8-puzzle e precisa da tabela carregada\n");
+        return;
+    }
+    connection->addPending();
+    queue.push(Request{ connection, id, poolFor(*info, state.cells), state });
+}
+
+void SolverServer::serveConnection(const std::shared_ptr<Connection>& connection) {
+    LineReader reader(connection->inFd);
+    std::string line;
+    while (reader.next(line)) {
+        handleLine(connection, line);
+    }
+    connection->waitPending();
+}
+
+void SolverServer::serveStream(int inFd, int outFd) {
+    serveConnection(std::make_shared<Connection>(inFd, outFd, false));
+}
+
+#ifdef _WIN32
+
+bool SolverServer::serveSocket(const std::string&) {
+    return false; // Sockets Unix não estão disponíveis nesta plataforma: use a entrada padrão
+}
+
+long long runClient(const std::string&, const SolverInfo&, const std::function<bool(PuzzleState&)>&,
+                    const std::function<void(const SolveResult&)>&, std::ostream& log) {
+    log << "Sockets Unix não estão disponíveis nesta plataforma" << std::endl;
+    return -1;
+}
+
+#else
+
+static bool socketAddress(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool SolverServer::serveSocket(const std::string& path) {
+    sockaddr_un address;
+    if (!socketAddress(path, address)) {
+        return false;
+    }
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return false;
+    }
+    ::unlink(path.c_str()); // Socket deixado por uma execução anterior
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 64) != 0) {
+        ::close(listener);
+        return false;
+    }
+    std::signal(SIGPIPE, SIG_IGN); // Cliente que desconecta não derruba o servidor
+
+    while (true) {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        // Uma thread de leitura por conexão; os pedidos vão para a fila comum
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd, fd, true);
+        std::thread([this, connection]() { serveConnection(connection); }).detach();
+    }
+}
+
+long long runClient(const std::string& path, const SolverInfo& info, const std::function<bool(PuzzleState&)>& read,
+                    const std::function<void(const SolveResult&)>& emit, std::ostream& log) {
+    sockaddr_un address;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || !socketAddress(path, address) || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return -1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Uma thread envia todos os pedidos enquanto a principal recebe as respostas
+    std::thread sender([&]() {
+        PuzzleState state;
+        long long index = 0;
+        while (read(state)) {
+            std::string line = std::to_string(index++) + " " + info.flag;
+            for (int i = 0; i < state.cells; ++i) {
+                line += " " + std::to_string(state.at(i));
+            }
+            line += '\n';
+            if (!writeAll(fd, line)) {
+                break;
+            }
+        }
+        ::shutdown(fd, SHUT_WR); // Fim dos pedidos: o servidor fecha depois da última resposta
+    });
+
+    std::map<long long, SolveResult> ready; // Respostas que ainda esperam as anteriores
+    long long next = 0;
+    LineReader reader(fd);
+    std::string line;
+    while (reader.next(line)) {
+        std::istringstream words(line);
+        long long id;
+        std::string status;
+        if (!(words >> id >> status)) {
+            continue;
+        }
+        SolveResult result;
+        if (status == "ok") {
+            std::string moves;
+            words >> result.record.nodes >> result.record.length >> result.record.seconds
+                  >> result.heuristicAverage >> result.startHeuristic >> moves;
+            if (result.record.length >= 0) {
+                result.record.flags = ResultRecord::SOLVED;
+                if (moves != "-" || result.record.length == 0) {
+                    result.record.flags |= ResultRecord::HAS_MOVES;
+                    for (char letter : moves) {
+                        const char* found = std::find(MOVE_LETTERS, MOVE_LETTERS + 4, letter);
+                        if (found != MOVE_LETTERS + 4) {
+                            result.record.moves.push_back(static_cast<uint8_t>(found - MOVE_LETTERS));
+                        }
+                    }
+                }
+            }
+        } else {
+            log << "Instância " << id << ": " << line.substr(line.find(status)) << std::endl;
+        }
+        ready[id] = std::move(result);
+        while (!ready.empty() && ready.begin()->first == next) {
+            emit(ready.begin()->second);
+            ready.erase(ready.begin());
+            next++;
+        }
+    }
+    sender.join();
+    ::close(fd);
+    return next;
+}
+
+#endif
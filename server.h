@@ -0,0 +1,75 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "solver.h"
+#include "batch.h"
+
+// Servidor de longa duração: carrega as tabelas uma vez e atende pedidos até ser
+// encerrado, pela entrada e saída padrão ou por um socket Unix com várias conexões
+// simultâneas. Os pedidos de todas as conexões vão para uma fila única, consumida por um
+// conjunto fixo de threads que reaproveitam os solvers já aquecidos (SolverPool) entre
+// pedidos. Protocolo, uma linha por mensagem:
+//   pedido:   "<id> <algoritmo> <peças...>", ex.: "7 -astar 1 2 0 3 4 5 6 7 8"
+//   resposta: "<id> ok <nós> <comprimento> <tempo> <média> <início> <movimentos>"
+//             "<id> erro <mensagem>"
+// O comprimento é -1 quando não há solução, e os movimentos vêm em letras U, L, R e D
+// ("-" se não houver). As respostas saem assim que ficam prontas, fora de ordem; o id
+// (qualquer palavra) as associa aos pedidos.
+class SolverServer {
+public:
+    // options vale para todos os algoritmos; o banco de padrões e a heurística pdb só são
+    // usados nos pedidos do 15-puzzle
+    SolverServer(const SolverOptions& _options, int threads);
+    ~SolverServer();
+
+    SolverServer(const SolverServer&) = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+
+    // Atende uma conexão formada pelos descritores dados até o fim da entrada e de todas
+    // as respostas (0 e 1 para a entrada e a saída padrão)
+    void serveStream(int inFd, int outFd);
+
+    // Escuta no socket Unix path até o processo ser encerrado; false se não conseguir
+    bool serveSocket(const std::string& path);
+
+    size_t requestsServed() const { return served.load(); }
+
+private:
+    struct Connection;
+
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        std::string id;
+        SolverPool* pool;
+        PuzzleState state;
+    };
+
+    SolverOptions options;
+    BoundedQueue<Request> queue;
+    std::vector<std::thread> workers;
+    std::mutex poolsMutex;
+    std::map<std::pair<std::string, int>, std::unique_ptr<SolverPool>> pools; // Por algoritmo e número de peças
+    std::atomic<size_t> served;
+
+    void work(); // Laço de uma thread de trabalho
+    void serveConnection(const std::shared_ptr<Connection>& connection); // Lê os pedidos até o fim
+    void handleLine(const std::shared_ptr<Connection>& connection, const std::string& line);
+    SolverPool* poolFor(const SolverInfo& info, int cells);
+};
+
+// Cliente: envia ao servidor no socket path as instâncias dadas por read, com o algoritmo
+// info, e passa os resultados para emit na ordem de envio. Retorna o número de instâncias,
+// ou -1 se não conseguir conectar; erros do servidor vão para log.
+long long runClient(const std::string& path, const SolverInfo& info, const std::function<bool(PuzzleState&)>& read,
+                    const std::function<void(const SolveResult&)>& emit, std::ostream& log);
+
+#endif // SERVER_H
@@ -0,0 +1,328 @@
+#include "solver.h"
+#include "astar.h"
+#include "gbfs.h"
+#include "bfs.h"
+#include "idfs.h"
+#include "idastar.h"
+#include "hdastar.h"
+#include "oracle.h"
+#include "pdb.h"
+#include <chrono>
+#include <sstream>
+
+std::vector<SolveResult> Solver::solveMany(const PuzzleState* states, size_t count) {
+    std::vector<SolveResult> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.push_back(solve(states[i]));
+    }
+    return results;
+}
+
+// Mede a busca e monta o resultado a partir do caminho devolvido
+template <typename Search>
+static SolveResult timedSearch(Search search) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    auto solutionPath = search();
+    auto end_time = std::chrono::high_resolution_clock::now();
+    SolveResult result;
+    result.record = makeResult(0, std::chrono::duration<double>(end_time - start_time).count(), solutionPath);
+    return result;
+}
+
+// Média das heurísticas dos nós expandidos; 0 quando nada foi expandido (início no objetivo)
+static double heuristicAverage(double sum, uint64_t expanded) {
+    return expanded > 0 ? sum / static_cast<double>(expanded) : 0.0;
+}
+
+// Copia as estatísticas do algoritmo para o resultado, com o tempo medido
+static void attachStats(SolveResult& result, const SearchStats& stats) {
+    result.stats = stats;
+    result.stats.seconds = result.record.seconds;
+}
+
+namespace {
+
+class AstarSolver : public Solver {
+public:
+    AstarSolver(const PuzzleState& goal, const SolverOptions& options) : astar(goal.toVector()) {
+        if (options.pdb && !options.pdb->empty()) {
+            astar.usePatternDatabase(options.pdb);
+        }
+        astar.setHeuristic(options.heuristic);
+    }
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return astar.findSolution(initial.toVector()); });
+        result.record.nodes = static_cast<uint64_t>(astar.getNodesCount());
+        result.heuristicAverage = astar.getHeuristicAverage();
+        result.startHeuristic = astar.getStartHeuristic();
+        attachStats(result, astar.getStats());
+        return result;
+    }
+
+private:
+    Astar astar;
+};
+
+class GBFSSolver : public Solver {
+public:
+    GBFSSolver(const PuzzleState& goal, const SolverOptions& options) : gbfs(goal.toVector()) {
+        if (options.pdb && !options.pdb->empty()) {
+            gbfs.usePatternDatabase(options.pdb);
+        }
+        gbfs.setHeuristic(options.heuristic);
+    }
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return gbfs.solve(initial.toVector()); });
+        result.record.nodes = static_cast<uint64_t>(gbfs.getNodesCount());
+        result.heuristicAverage = gbfs.getHeuristicAverage();
+        result.startHeuristic = gbfs.getStartHeuristic();
+        attachStats(result, gbfs.getStats());
+        return result;
+    }
+
+private:
+    GBFS gbfs;
+};
+
+class BFSSolver : public Solver {
+public:
+    BFSSolver(const PuzzleState& goal, const SolverOptions& options) : bfs(goal.toVector()) {
+        bfs.setBidirectional(options.bidirectional);
+    }
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return bfs.solve(initial.toVector()); });
+        result.record.nodes = static_cast<uint64_t>(bfs.getNodesCount());
+        result.startHeuristic = bfs.getSolutionDepth();
+        attachStats(result, bfs.getStats());
+        return result;
+    }
+
+private:
+    BFS bfs;
+};
+
+class IDAStarSolver : public Solver {
+public:
+    IDAStarSolver(const PuzzleState& goal, const SolverOptions& options) : idaStar(goal.toVector()), threads(options.searchThreads) {
+        if (options.pdb && !options.pdb->empty()) {
+            idaStar.usePatternDatabase(options.pdb);
+        }
+        idaStar.setHeuristic(options.heuristic);
+        idaStar.useTranspositionTable(options.transpositionBytes);
+        idaStar.useThreads(options.searchThreads);
+    }
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return idaStar.idaStar(initial.toVector()); });
+        result.record.nodes = static_cast<uint64_t>(idaStar.getNodesExpanded());
+        result.heuristicAverage = heuristicAverage(idaStar.getHeuristicSum(), idaStar.getStats().expanded);
+        result.startHeuristic = idaStar.getStartHeuristic();
+        attachStats(result, idaStar.getStats());
+
+        std::ostringstream details;
+        const TranspositionTable& table = idaStar.getTranspositionTable();
+        if (table.enabled()) { // Consultas, acertos, taxa de acerto, cortes e memória da tabela
+            details << "TT: " << table.probes << ", " << table.hits << ", " << table.hitRate() << ", "
+                    << table.cutoffs << ", " << table.bytes() << std::endl;
+        }
+        if (threads > 1) { // Nós e nós/s de cada thread, e a fração do tempo em que elas trabalharam
+            double seconds = result.record.seconds;
+            double busy = 0;
+            details << "Threads:";
+            for (const IdaThreadStats& stats : idaStar.getThreadStats()) {
+                details << " " << stats.nodes << " (" << stats.nodesPerSecond() << " nós/s)";
+                busy += stats.busySeconds;
+            }
+            details << ", eficiência " << (seconds > 0 ? busy / (threads * seconds) : 0.0) << std::endl;
+        }
+        result.details = details.str();
+        return result;
+    }
+
+private:
+    IDAStar idaStar;
+    int threads;
+};
+
+class IDFSSolver : public Solver {
+public:
+    IDFSSolver(const PuzzleState& goal, const SolverOptions&) : puzzle(goal.toVector()), manhattan(goal) {}
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() {
+            puzzle.IDFS(initial.toVector());
+            return puzzle.path;
+        });
+        result.record.nodes = puzzle.stats.expanded;
+        result.startHeuristic = manhattan.evaluate(initial);
+        attachStats(result, puzzle.stats);
+        return result;
+    }
+
+private:
+    IDFSPuzzle puzzle;
+    ManhattanTable manhattan;
+};
+
+class HDAStarSolver : public Solver {
+public:
+    HDAStarSolver(const PuzzleState& goal, const SolverOptions& options) : hda(goal.toVector(), options.searchThreads), threads(options.searchThreads) {
+        if (options.pdb && !options.pdb->empty()) {
+            hda.usePatternDatabase(options.pdb);
+        }
+        hda.setHeuristic(options.heuristic);
+    }
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return hda.solve(initial.toVector()); });
+        result.record.nodes = hda.stats.expanded;
+        result.heuristicAverage = heuristicAverage(hda.heuristicSum, hda.stats.expanded);
+        result.startHeuristic = hda.startHeuristic;
+        attachStats(result, hda.stats);
+        if (threads > 1) { // Nós e nós/s de cada thread
+            double seconds = result.record.seconds;
+            std::ostringstream details;
+            details << "Threads:";
+            for (long long nodes : hda.threadNodes) {
+                details << " " << nodes << " (" << (seconds > 0 ? nodes / seconds : 0.0) << " nós/s)";
+            }
+            details << std::endl;
+            result.details = details.str();
+        }
+        return result;
+    }
+
+private:
+    HDAStar hda;
+    int threads;
+};
+
+class OracleSolver : public Solver {
+public:
+    OracleSolver(const PuzzleState&, const SolverOptions& options) : oracle(*options.oracle) {}
+
+    SolveResult solve(const PuzzleState& initial) override {
+        SolveResult result = timedSearch([&]() { return oracle.solve(initial); });
+        result.startHeuristic = oracle.distance(initial);
+        attachStats(result, SearchStats()); // Só consultas à tabela: nada a contar
+        return result;
+    }
+
+private:
+    const DistanceOracle& oracle; // Só leitura: pode ser compartilhada entre as threads
+};
+
+template <typename T>
+std::unique_ptr<Solver> create(const PuzzleState& goal, const SolverOptions& options) {
+    return std::unique_ptr<Solver>(new T(goal, options));
+}
+
+} // namespace
+
+const std::vector<SolverInfo>& solverRegistry() {
+    static const std::vector<SolverInfo> registry = {
+        { "-bfs", "BFS", 8, create<BFSSolver> },
+        { "-gbfs", "GBFS", 8, create<GBFSSolver> },
+        { "-astar", "A*", 8, create<AstarSolver> },
+        { "-idastar", "IDA*", 8, create<IDAStarSolver> },
+        { "-idfs", "IDFS", 8, create<IDFSSolver> },
+        { "-astar15", "Astar15", 15, create<AstarSolver> }, // O mesmo A*, com o 15-puzzle por padrão
+        { "-hdastar", "HDA*", 15, create<HDAStarSolver> },
+        { "-oracle", "Oracle", 8, create<OracleSolver> },
+    };
+    return registry;
+}
+
+const SolverInfo* findSolver(const std::string& flag) {
+    for (const SolverInfo& info : solverRegistry()) {
+        if (flag == info.flag) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+std::string formatResult(const SolverInfo& info, const SolveResult& result) {
+    std::ostringstream out;
+    if (!(result.record.flags & ResultRecord::SOLVED)) {
+        out << info.label << ": Nenhuma solução encontrada." << std::endl;
+        return out.str();
+    }
+    out << info.label << ": " << result.record.nodes << ", " << result.record.length << ", "
+        << result.record.seconds << ", " << result.heuristicAverage << ", "
+        << result.startHeuristic << std::endl;
+    out << result.details;
+    return out.str();
+}
+
+std::string formatStatsJson(const SolverInfo& info, const SolveResult& result) {
+    const SearchStats& stats = result.stats;
+    std::ostringstream out;
+    out << "{\"algorithm\":\"" << info.label << "\",\"solved\":"
+        << ((result.record.flags & ResultRecord::SOLVED) ? "true" : "false")
+        << ",\"length\":" << result.record.length << ",\"seconds\":" << stats.seconds
+        << ",\"expanded\":" << stats.expanded << ",\"generated\":" << stats.generated
+        << ",\"duplicates\":" << stats.duplicates << ",\"reopened\":" << stats.reopened
+        << ",\"peak_open\":" << stats.peakOpen << ",\"peak_closed\":" << stats.peakClosed
+        << ",\"peak_bytes\":" << stats.peakBytes << ",\"nodes_per_second\":" << stats.nodesPerSecond()
+        << ",\"iterations\":[";
+    for (size_t i = 0; i < stats.iterations.size(); ++i) {
+        const IterationStats& iteration = stats.iterations[i];
+        out << (i ? "," : "") << "{\"bound\":" << iteration.bound << ",\"expanded\":" << iteration.expanded
+            << ",\"generated\":" << iteration.generated << "}";
+    }
+    out << "]}" << std::endl;
+    return out.str();
+}
+
+std::string statsCsvHeader() {
+    return "algorithm,solved,length,seconds,expanded,generated,duplicates,reopened,"
+           "peak_open,peak_closed,peak_bytes,nodes_per_second,iterations\n";
+}
+
+std::string formatStatsCsv(const SolverInfo& info, const SolveResult& result) {
+    const SearchStats& stats = result.stats;
+    std::ostringstream out;
+    out << info.label << "," << ((result.record.flags & ResultRecord::SOLVED) ? 1 : 0) << ","
+        << result.record.length << "," << stats.seconds << "," << stats.expanded << ","
+        << stats.generated << "," << stats.duplicates << "," << stats.reopened << ","
+        << stats.peakOpen << "," << stats.peakClosed << "," << stats.peakBytes << ","
+        << stats.nodesPerSecond() << ",";
+    for (size_t i = 0; i < stats.iterations.size(); ++i) {
+        const IterationStats& iteration = stats.iterations[i];
+        out << (i ? ";" : "") << iteration.bound << ":" << iteration.expanded << ":" << iteration.generated;
+    }
+    out << std::endl;
+    return out.str();
+}
+
+SolverPool::SolverPool(const SolverInfo& _info, const PuzzleState& _goal, const SolverOptions& _options)
+    : info(_info), goal(_goal), options(_options) {}
+
+std::unique_ptr<Solver> SolverPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idle.empty()) {
+            std::unique_ptr<Solver> solver = std::move(idle.back());
+            idle.pop_back();
+            return solver;
+        }
+    }
+    return info.create(goal, options); // Criado fora da trava: pode montar tabelas grandes
+}
+
+void SolverPool::release(std::unique_ptr<Solver> solver) {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(std::move(solver));
+}
+
+SolveResult SolverPool::solve(const PuzzleState& initial) {
+    std::unique_ptr<Solver> solver = acquire();
+    SolveResult result = solver->solve(initial);
+    release(std::move(solver));
+    return result;
+}
@@ -0,0 +1,101 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "puzzlestate.h"
+#include "heuristic.h"
+#include "binaryformat.h"
+#include "searchstats.h"
+
+class AdditivePDB;
+class DistanceOracle;
+
+// Interface comum dos algoritmos de busca. Cada implementação guarda o objeto do
+// algoritmo (tabelas da heurística, nós, lista aberta, conjunto fechado) e o reaproveita
+// de uma instância para a outra; um Solver não é seguro para uso por várias threads ao
+// mesmo tempo (ver SolverPool).
+
+// Resultado uniforme de uma instância
+struct SolveResult {
+    ResultRecord record; // Nós, comprimento, tempo e movimentos (length -1 sem solução)
+    double heuristicAverage; // Quarta coluna da linha de texto
+    long long startHeuristic; // Quinta coluna (no BFS, a profundidade; no IDFS e no oráculo, a distância)
+    std::string details; // Linhas extras da saída em texto (tabela de transposição, threads)
+    SearchStats stats; // Contadores detalhados da busca (ver -stats)
+
+    SolveResult() : heuristicAverage(0), startHeuristic(0) {}
+};
+
+// Configuração compartilhada por todas as instâncias de um lote
+struct SolverOptions {
+    HeuristicType heuristic;
+    const AdditivePDB* pdb; // Banco de padrões do 15-puzzle (pode ser nulo)
+    const DistanceOracle* oracle; // Tabela de distâncias do 8-puzzle (só -oracle)
+    size_t transpositionBytes; // Tabela de transposição do IDA* (0 desliga)
+    int searchThreads; // Threads por busca do IDA* e do HDA*
+    bool bidirectional; // BFS bidirecional
+
+    SolverOptions()
+        : heuristic(HEURISTIC_MANHATTAN), pdb(nullptr), oracle(nullptr), transpositionBytes(0), searchThreads(1), bidirectional(false) {}
+};
+
+class Solver {
+public:
+    virtual ~Solver() {}
+
+    virtual SolveResult solve(const PuzzleState& initial) = 0;
+
+    // Resolve as instâncias em sequência com o mesmo objeto, sem reconstruí-lo
+    virtual std::vector<SolveResult> solveMany(const PuzzleState* states, size_t count);
+    std::vector<SolveResult> solveMany(const std::vector<PuzzleState>& states) {
+        return solveMany(states.data(), states.size());
+    }
+};
+
+// Entrada do registro: o nome na linha de comando, o rótulo da saída em texto e a fábrica
+struct SolverInfo {
+    const char* flag; // Opção da linha de comando, como "-astar"
+    const char* label; // Prefixo das linhas de resultado, como "A*"
+    int defaultSize; // Tabuleiro padrão (8 ou 15)
+    std::unique_ptr<Solver> (*create)(const PuzzleState& goal, const SolverOptions& options);
+};
+
+// Todos os algoritmos disponíveis, na ordem em que aparecem na ajuda
+const std::vector<SolverInfo>& solverRegistry();
+const SolverInfo* findSolver(const std::string& flag); // nullptr se não existir
+
+// Linha(s) de texto do resultado, no formato "Rótulo: nós, comprimento, tempo, média, início"
+std::string formatResult(const SolverInfo& info, const SolveResult& result);
+
+// Estatísticas da instância em JSON (um objeto por linha) ou em CSV (uma linha, com as
+// colunas de statsCsvHeader); as iterações do IDA* e do IDFS vão como lista no JSON e
+// como "limite:expandidos:gerados" separados por ';' no CSV
+std::string formatStatsJson(const SolverInfo& info, const SolveResult& result);
+std::string formatStatsCsv(const SolverInfo& info, const SolveResult& result);
+std::string statsCsvHeader();
+
+// Solvers ociosos de um algoritmo, para que threads de trabalho reaproveitem objetos já
+// aquecidos em vez de criar um por instância
+class SolverPool {
+public:
+    SolverPool(const SolverInfo& _info, const PuzzleState& _goal, const SolverOptions& _options);
+
+    std::unique_ptr<Solver> acquire(); // Um solver ocioso, ou um novo se não houver
+    void release(std::unique_ptr<Solver> solver);
+
+    SolveResult solve(const PuzzleState& initial); // acquire, solve e release
+    const SolverInfo& getInfo() const { return info; }
+
+private:
+    const SolverInfo& info;
+    PuzzleState goal;
+    SolverOptions options;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Solver>> idle;
+};
+
+#endif // SOLVER_H
@@ -0,0 +1,204 @@
+#ifndef STATESET_H
+#define STATESET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "puzzlestate.h"
+
+// Conjunto de estados com endereçamento aberto (sondagem linear) sobre um vetor plano
+// de chaves compactadas. A chave 0 marca uma posição vazia: nenhum estado válido tem
+// todas as peças iguais a zero, então ela nunca colide com um estado real.
+class StateSet {
+public:
+    // Acima desta capacidade, clear() volta à capacidade inicial em vez de zerar a tabela
+    // inteira: depois de uma busca grande, as buscas pequenas seguintes não pagam por ela
+    static const size_t RETAINED_CAPACITY = size_t(1) << 18;
+
+    explicit StateSet(size_t initialCapacity = 1024) : count(0) {
+        baseCapacity = 16;
+        while (baseCapacity < initialCapacity) {
+            baseCapacity <<= 1;
+        }
+        keys.assign(baseCapacity, 0);
+        mask = baseCapacity - 1;
+    }
+
+    // Insere a chave; retorna false se ela já estava no conjunto
+    bool insert(uint64_t key) {
+        if ((count + 1) * 10 > keys.size() * 7) { // Cresce acima de 70% de ocupação
+            grow();
+        }
+        size_t i = mixKey(key) & mask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+        keys[i] = key;
+        count++;
+        return true;
+    }
+
+    bool contains(uint64_t key) const {
+        size_t i = mixKey(key) & mask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) {
+                return true;
+            }
+            i = (i + 1) & mask;
+        }
+        return false;
+    }
+
+    bool insert(const PuzzleState& state) { return insert(state.key()); }
+    bool contains(const PuzzleState& state) const { return contains(state.key()); }
+
+    // Esvazia o conjunto mantendo a capacidade atual, se ela não passou de RETAINED_CAPACITY
+    void clear() {
+        if (keys.size() > RETAINED_CAPACITY) {
+            std::vector<uint64_t>(baseCapacity, 0).swap(keys);
+            mask = baseCapacity - 1;
+        } else {
+            std::fill(keys.begin(), keys.end(), 0);
+        }
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Memória ocupada pela tabela, em bytes
+    size_t bytesUsed() const {
+        return keys.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    std::vector<uint64_t> keys; // Tabela plana; 0 indica posição vazia
+    size_t mask; // Capacidade - 1 (a capacidade é sempre potência de 2)
+    size_t count; // Número de chaves armazenadas
+    size_t baseCapacity; // Capacidade inicial, restaurada por clear()
+
+    // Dobra a capacidade e reinsere todas as chaves
+    void grow() {
+        std::vector<uint64_t> old;
+        old.swap(keys);
+        keys.assign(old.size() * 2, 0);
+        mask = keys.size() - 1;
+        for (uint64_t key : old) {
+            if (key != 0) {
+                size_t i = mixKey(key) & mask;
+                while (keys[i] != 0) {
+                    i = (i + 1) & mask;
+                }
+                keys[i] = key;
+            }
+        }
+    }
+};
+
+// Mapa de estado compactado para um valor, com o mesmo endereçamento aberto do
+// StateSet (chave 0 = posição vazia). Chaves e valores ficam em vetores paralelos.
+template <typename V>
+class StateMap {
+public:
+    explicit StateMap(size_t initialCapacity = 1024) : count(0) {
+        baseCapacity = 16;
+        while (baseCapacity < initialCapacity) {
+            baseCapacity <<= 1;
+        }
+        keys.assign(baseCapacity, 0);
+        values.resize(baseCapacity);
+        mask = baseCapacity - 1;
+    }
+
+    // Esvazia o mapa mantendo a capacidade, se ela não passou de RETAINED_CAPACITY (ver StateSet)
+    void clear() {
+        if (keys.size() > StateSet::RETAINED_CAPACITY) {
+            std::vector<uint64_t>(baseCapacity, 0).swap(keys);
+            std::vector<V>(baseCapacity).swap(values);
+            mask = baseCapacity - 1;
+        } else {
+            std::fill(keys.begin(), keys.end(), 0);
+        }
+        count = 0;
+    }
+
+    // Valor da chave, ou nullptr se ela não está no mapa (válido até a próxima inserção)
+    V* find(uint64_t key) {
+        size_t i = mixKey(key) & mask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) {
+                return &values[i];
+            }
+            i = (i + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    const V* find(uint64_t key) const {
+        return const_cast<StateMap*>(this)->find(key);
+    }
+
+    // Valor da chave, inserindo-a com V() se ela não existe; inserted diz se foi inserida
+    V& insert(uint64_t key, bool& inserted) {
+        if ((count + 1) * 10 > keys.size() * 7) { // Cresce acima de 70% de ocupação
+            grow();
+        }
+        size_t i = mixKey(key) & mask;
+        while (keys[i] != 0) {
+            if (keys[i] == key) {
+                inserted = false;
+                return values[i];
+            }
+            i = (i + 1) & mask;
+        }
+        keys[i] = key;
+        values[i] = V();
+        count++;
+        inserted = true;
+        return values[i];
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Memória ocupada pela tabela, em bytes
+    size_t bytesUsed() const {
+        return keys.capacity() * sizeof(uint64_t) + values.capacity() * sizeof(V);
+    }
+
+private:
+    std::vector<uint64_t> keys; // Tabela plana; 0 indica posição vazia
+    std::vector<V> values; // Valor de cada posição de keys
+    size_t mask; // Capacidade - 1 (a capacidade é sempre potência de 2)
+    size_t count; // Número de chaves armazenadas
+    size_t baseCapacity; // Capacidade inicial, restaurada por clear()
+
+    // Dobra a capacidade e reinsere todas as chaves
+    void grow() {
+        std::vector<uint64_t> oldKeys;
+        std::vector<V> oldValues;
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        keys.assign(oldKeys.size() * 2, 0);
+        values.resize(keys.size());
+        mask = keys.size() - 1;
+        for (size_t j = 0; j < oldKeys.size(); ++j) {
+            if (oldKeys[j] != 0) {
+                size_t i = mixKey(oldKeys[j]) & mask;
+                while (keys[i] != 0) {
+                    i = (i + 1) & mask;
+                }
+                keys[i] = oldKeys[j];
+                values[i] = oldValues[j];
+            }
+        }
+    }
+};
+
+#endif // STATESET_H
@@ -0,0 +1,80 @@
+#ifndef SUCCESSORS_H
+#define SUCCESSORS_H
+
+#include "puzzlestate.h"
+#include "heuristic.h"
+
+// Faixa preguiçosa dos sucessores de um estado, na ordem cima, esquerda, direita, baixo.
+// Nada é alocado nem montado: cada sucessor traz só o movimento e a nova posição do
+// zero, o chamador faz os testes de duplicata e de poda e só então monta o filho com
+// state() e calcula a variação da heurística com hDelta(). Domain fornece a tabela de
+// movimentos: um PuzzleDomain nos laços especializados, RuntimeDomain nos demais.
+template <typename Domain>
+class BasicSuccessors {
+public:
+    explicit BasicSuccessors(const PuzzleState& _state)
+        : state(_state), targets(Domain::table(_state.width).target[_state.zero]), heuristic(nullptr), h(0) {}
+
+    // Com a heurística do estado, para que os sucessores possam calcular hDelta()
+    BasicSuccessors(const PuzzleState& _state, const Heuristic& _heuristic, int _h)
+        : state(_state), targets(Domain::table(_state.width).target[_state.zero]), heuristic(&_heuristic), h(_h) {}
+
+    class Successor {
+    public:
+        int move; // Movimento do zero (ver Move)
+        int zero; // Nova posição do zero
+
+        Successor(const BasicSuccessors* _range, int _move, int _zero) : move(_move), zero(_zero), range(_range) {}
+
+        PuzzleState state() const { return range->state.moved(zero); } // Monta o filho
+
+        // Variação da heurística do pai para o filho (0 se a faixa não recebeu heurística)
+        int hDelta() const {
+            return range->heuristic ? range->heuristic->child(range->state, range->h, zero) - range->h : 0;
+        }
+
+    private:
+        const BasicSuccessors* range;
+    };
+
+    class iterator {
+    public:
+        iterator(const BasicSuccessors* _range, int _move) : range(_range), move(_move) {
+            skipInvalid();
+        }
+
+        Successor operator*() const { return Successor(range, move, range->targets[move]); }
+
+        iterator& operator++() {
+            ++move;
+            skipInvalid();
+            return *this;
+        }
+
+        bool operator!=(const iterator& other) const { return move != other.move; }
+
+    private:
+        const BasicSuccessors* range;
+        int move;
+
+        void skipInvalid() {
+            while (move <= MOVE_DOWN && range->targets[move] < 0) {
+                ++move;
+            }
+        }
+    };
+
+    iterator begin() const { return iterator(this, MOVE_UP); }
+    iterator end() const { return iterator(this, MOVE_NONE); }
+
+private:
+    PuzzleState state;
+    const int8_t* targets; // Destino do zero para cada movimento (-1 se inválido)
+    const Heuristic* heuristic;
+    int h; // Heurística de state
+};
+
+typedef BasicSuccessors<RuntimeDomain> Successors;
+typedef Successors::Successor Successor;
+
+#endif // SUCCESSORS_H
@@ -0,0 +1,157 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "puzzlestate.h"
+
+// Tabela de transposição de tamanho fixo para o IDA*. Cada entrada guarda, para um
+// estado compactado, o menor g com que ele foi alcançado na busca atual e um limite
+// inferior da distância até o objetivo (a heurística, melhorada pelo valor propagado
+// quando a subárvore é esgotada). A tabela é com perdas: cada balde tem 4 entradas
+// (uma linha de cache) e, quando cheio, perde a entrada mais rasa da busca.
+class TranspositionTable {
+public:
+    struct Entry {
+        uint64_t key; // Estado compactado (0 = entrada vazia)
+        uint16_t stamp; // Iteração em que a entrada foi escrita
+        uint8_t g; // Menor custo g com que o estado foi alcançado
+        uint8_t h; // Limite inferior da distância até o objetivo
+        uint8_t searched; // Se a subárvore foi esgotada na iteração stamp
+        uint8_t padding[3];
+    };
+
+    static const int BUCKET = 4; // Entradas por balde
+
+    uint64_t probes; // Consultas feitas
+    uint64_t hits; // Consultas que encontraram o estado
+    uint64_t cutoffs; // Subárvores cortadas por transposição
+    uint64_t stores; // Entradas gravadas
+    uint64_t overwrites; // Entradas válidas substituídas
+
+    TranspositionTable() : probes(0), hits(0), cutoffs(0), stores(0), overwrites(0), mask(0), stamp(1), searchStart(1) {}
+
+    // Reserva até bytes de memória (arredondado para baixo em potência de dois); 0 desliga
+    void resize(size_t bytes) {
+        size_t buckets = 0;
+        if (bytes >= BUCKET * sizeof(Entry)) {
+            buckets = 1;
+            while (buckets * 2 * BUCKET * sizeof(Entry) <= bytes) {
+                buckets <<= 1;
+            }
+        }
+        entries.assign(buckets * BUCKET, Entry());
+        mask = buckets ? buckets - 1 : 0;
+        stamp = 1;
+        searchStart = 1;
+    }
+
+    bool enabled() const { return !entries.empty(); }
+    size_t bytes() const { return entries.size() * sizeof(Entry); }
+    double hitRate() const { return probes ? static_cast<double>(hits) / probes : 0.0; }
+
+    // Início de uma nova busca: os valores de g antigos deixam de valer (mas os de h
+    // continuam, pois dependem só do objetivo) e os contadores voltam a zero, para que
+    // sejam os de cada instância mesmo quando o objeto é reaproveitado
+    void newSearch() {
+        probes = hits = cutoffs = stores = overwrites = 0;
+        newIteration();
+        searchStart = stamp;
+    }
+
+    // Início de uma nova iteração do IDA*
+    void newIteration() {
+        if (stamp == UINT16_MAX) { // O carimbo esgotou: recomeça com a tabela vazia
+            std::fill(entries.begin(), entries.end(), Entry());
+            stamp = 0;
+            searchStart = 1;
+        }
+        stamp++;
+    }
+
+    // Se o g da entrada é da busca atual
+    bool currentSearch(const Entry& entry) const { return entry.stamp >= searchStart; }
+
+    // Se a subárvore da entrada já foi esgotada nesta iteração
+    bool searchedThisIteration(const Entry& entry) const { return entry.searched && entry.stamp == stamp; }
+
+    // Procura o estado; retorna nullptr se ele não está na tabela
+    Entry* find(uint64_t key) {
+        probes++;
+        Entry* entry = lookup(key);
+        if (entry) {
+            hits++;
+        }
+        return entry;
+    }
+
+    // Registra o estado alcançado com custo g e limite inferior h. Se o balde estiver
+    // cheio, substitui a entrada de busca antiga ou, senão, a de maior g (a mais rasa
+    // em profundidade restante), desde que ela não seja mais valiosa que a nova.
+    void store(uint64_t key, int g, int h) {
+        Entry* bucket = &entries[(mixKey(key) & mask) * BUCKET];
+        Entry* victim = &bucket[0];
+        for (int i = 0; i < BUCKET; ++i) {
+            if (bucket[i].key == key) {
+                victim = &bucket[i];
+                break;
+            }
+            if (replaceRank(bucket[i]) > replaceRank(*victim)) {
+                victim = &bucket[i];
+            }
+        }
+        if (victim->key != key) {
+            if (victim->key != 0 && currentSearch(*victim)) {
+                if (victim->g < g) {
+                    return; // Todas as entradas do balde são mais profundas que a nova
+                }
+                overwrites++;
+            }
+            victim->key = key;
+            victim->h = 0;
+        }
+        stores++;
+        victim->g = static_cast<uint8_t>(g);
+        victim->h = static_cast<uint8_t>(std::max<int>(victim->h, h));
+        victim->stamp = stamp;
+        victim->searched = 0;
+    }
+
+    // Depois de esgotar a subárvore do estado alcançado com custo g, guarda o limite
+    // inferior propagado h (se a entrada ainda estiver na tabela)
+    void update(uint64_t key, int g, int h) {
+        Entry* entry = lookup(key);
+        if (entry && entry->g == g && entry->stamp == stamp) {
+            entry->h = static_cast<uint8_t>(std::min(255, std::max<int>(entry->h, h)));
+            entry->searched = 1;
+        }
+    }
+
+private:
+    std::vector<Entry> entries; // Baldes de BUCKET entradas consecutivas
+    size_t mask; // Número de baldes - 1
+    uint16_t stamp; // Iteração atual
+    uint16_t searchStart; // Primeira iteração da busca atual
+
+    // Preferência para substituição: vazia, depois de busca antiga, depois a de maior g
+    int replaceRank(const Entry& entry) const {
+        if (entry.key == 0) {
+            return 1 << 10;
+        }
+        return currentSearch(entry) ? entry.g : 1 << 9;
+    }
+
+    Entry* lookup(uint64_t key) {
+        Entry* bucket = &entries[(mixKey(key) & mask) * BUCKET];
+        for (int i = 0; i < BUCKET; ++i) {
+            if (bucket[i].key == key) {
+                return &bucket[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+#endif // TRANSPOSITION_H